@@ -1,51 +1,59 @@
 #include "GameManager.h"
 #include "platform.h"
+#include "assets.h"
+#include "snapshot.h"
 #include <algorithm>
 #include <cstring>
 #include <cstdio>
+#include <utility>
 
 using namespace Platform;
 
-static int   gHigh[static_cast<int>(GameID::COUNT)] = {0,0};
+static constexpr unsigned BOOT_MS = 2000;
+static constexpr unsigned WARM_BOOT_SKIP_MS = 1700;  // Warm start: only hold the final logo
+static constexpr int BOOT_LOGO_Y = 25;
+static constexpr int BOOT_SLIDE_COLS = 32;               // columns the logo scrolls into place
+static constexpr unsigned MENU_OUT_MS = 320;             // list slides out when a game is picked
 
-static enum class SysState { BOOT, MENU, IN_GAME, GAME_OVER } gState = SysState::BOOT;
-static unsigned long gBootStart = 0;
+static const char* gMenuItems[] = { "1.Snake", "2.Pong", "3.Sleep", "4.Big Snake" };
+static_assert(sizeof(gMenuItems) / sizeof(gMenuItems[0]) == MENU_COUNT, "MENU_COUNT in GameManager.h");
 
-static int gMenuIndex = 0;
-static const char* gMenuItems[] = { "1.Snake", "2.Pong", "3.Sleep" };
-static constexpr int gMenuCount = 3;
+// Storage key of each game's high score, by GameID
+static const char* const gHighScoreKeys[] = { "hs_snake", "hs_pong", "hs_bigsnake" };
+static_assert(sizeof(gHighScoreKeys) / sizeof(gHighScoreKeys[0]) == static_cast<int>(GameID::COUNT), "a high score key per game");
 
-static GameID        gActiveGame = GameID::SNAKE;
-static bool          gGameInited = false;
-static int           gCurrentScore = 0;
-static bool          gExitReq = false;
-static bool          gGameOver = false;
+// Display name of each game (status bar, Get Ready, Game Over), by GameID
+static const char* const gGameNames[] = { "SNAKE", "PONG", "BIG SNAKE" };
+static_assert(sizeof(gGameNames) / sizeof(gGameNames[0]) == static_cast<int>(GameID::COUNT), "a name per game");
 
 // Enhanced button debouncing with exit state tracking
-static unsigned long lastDebounceA = 0, lastDebounceB = 0;
 static constexpr unsigned DEBOUNCE_MS = 200;  // Increased debounce time
 static constexpr unsigned EXIT_HOLD_MS = 1500;
 
-// Proper edge detection with state tracking
-static bool prevAState = false, prevBState = false;
-static bool currentAState = false, currentBState = false;
-
 // Exit state management
-static bool wasInExitSequence = false;
-static unsigned long exitSequenceEndTime = 0;
 static constexpr unsigned EXIT_COOLDOWN_MS = 500;  // Cooldown after exit
+static constexpr unsigned RELEASE_SETTLE_MS = 150;     // buttons must stay up this long
+static constexpr unsigned RELEASE_TIMEOUT_MS = 3000;   // give up waiting for a release
+static constexpr unsigned GAME_OVER_MS = 1500;
+static constexpr unsigned SLEEP_MS = 500;
+
+// Background work
+static constexpr unsigned BOOT_FRAME_MS = 10;          // boot animation frame pacing
+static constexpr unsigned QUIET_SLACK_MS = 50;         // a static screen may run this late
+static constexpr unsigned STORAGE_COMMIT_COST_MS = 30; // ESP32 flash sector erase + write
+static constexpr unsigned STORAGE_COMMIT_MAX_WAIT_MS = 10000;
+static constexpr unsigned DIAG_PERIOD_MS = 1000;
 
 // Frame rate limiting for smooth gameplay
-static unsigned long lastFrameTime = 0;
 static constexpr unsigned TARGET_FRAME_MS = 16;  // ~60 FPS
 
-static bool buttonPressedRising(bool now, bool& prev, unsigned long& lastTs) { 
-  unsigned long t = Millis();
+static bool buttonPressedRising(GameContext& ctx, bool now, bool& prev, uint64_t& lastTs) { 
+  uint64_t t = ctx.frame.now;
   bool rising = now && !prev;
   prev = now; // Always update state
   
   // Ignore inputs during exit cooldown period
-  if (wasInExitSequence && (t - exitSequenceEndTime) < EXIT_COOLDOWN_MS) {
+  if (ctx.wasInExitSequence && (t - ctx.exitSequenceEndTime) < EXIT_COOLDOWN_MS) {
     return false;
   }
   
@@ -56,340 +64,676 @@ static bool buttonPressedRising(bool now, bool& prev, unsigned long& lastTs) {
   return false; 
 }
 
-// GAME_OVER overlay timing
-static unsigned long gGameOverUntil = 0;
-static const char*   gGameOverName  = nullptr;
-static int           gGameOverScore = 0;
-
-// Frame rate control with boot animation exception
-static void limitFrameRate(bool allowFastUpdates = false) {
+// Frame rate control with boot animation exception. Background tasks get
+// whatever is left of the frame before its deadline.
+static void limitFrameRate(GameContext& ctx, bool allowFastUpdates = false) {
+  Device& dev = ctx.dev;
+  auto clock = [&dev] { return dev.Millis(); };
   if (allowFastUpdates) {
     // For boot animation, allow faster updates
-    Delay(10);
+    uint64_t start = dev.Millis();
+    ctx.tasks.Run(start + BOOT_FRAME_MS, clock);
+    uint64_t spent = dev.Millis() - start;
+    if (spent < BOOT_FRAME_MS) dev.Delay(BOOT_FRAME_MS - static_cast<unsigned>(spent));
+    ctx.lastFrameTime = dev.Millis();
     return;
   }
-  
-  unsigned long now = Millis();
-  unsigned long elapsed = now - lastFrameTime;
-  
+
+  // Nothing moves on the menu or the game-over screen, so a late frame
+  // there costs nothing visible
+  bool quiet = ctx.state == SysState::MENU || ctx.state == SysState::GAME_OVER;
+  {
+    BLOOP_TRACE_SCOPE("tasks");
+    ctx.tasks.Run(ctx.lastFrameTime + TARGET_FRAME_MS + (quiet ? QUIET_SLACK_MS : 0), clock);
+  }
+
+  uint64_t now = dev.Millis();
+  uint64_t elapsed = now - ctx.lastFrameTime;
+  if (elapsed > TARGET_FRAME_MS) ctx.diag.lateFrames++;
+
   if (elapsed < TARGET_FRAME_MS) {
-    Delay(TARGET_FRAME_MS - elapsed);
+    unsigned wait = TARGET_FRAME_MS - static_cast<unsigned>(elapsed);
+    dev.Delay(wait);
+    now += wait;
   }
-  lastFrameTime = Millis();
+  ctx.lastFrameTime = now;
+}
+
+// Snapshot the clock and buttons for this frame
+static void beginFrame(GameContext& ctx) {
+  uint64_t now = ctx.dev.Millis();
+  ctx.frame.dt = static_cast<uint32_t>(now - ctx.frame.now);
+  ctx.frame.now = now;
+  ctx.frame.index++;
+  ctx.dev.PollInput(now);
 }
 
-// Wait for all buttons to be released with exit sequence tracking
-static void waitForButtonRelease() {
+// Waits, frame by frame, until both buttons are up and still up
+// RELEASE_SETTLE_MS later (or RELEASE_TIMEOUT_MS passed), then restarts edge
+// detection so the held press does not carry over
+static Flow buttonsReleased(GameContext& ctx) {
   // Mark that we're ending an exit sequence
-  if (wasInExitSequence) {
-    exitSequenceEndTime = Millis();
+  if (ctx.wasInExitSequence) {
+    ctx.exitSequenceEndTime = ctx.frame.now;
   }
-  
-  unsigned long startWait = Millis();
-  while (true) {
-    InputState s = getInputState();
-    if (!s.buttonA && !s.buttonB) {
-      // Wait extra time to ensure clean release
-      Delay(150);
-      
-      // Double-check after delay
-      s = getInputState();
-      if (!s.buttonA && !s.buttonB) {
-        break;
-      }
-    }
-    
-    // Prevent infinite loop
-    if (Millis() - startWait > 3000) {
-      break; // Safety timeout after 3 seconds
+
+  uint64_t startWait = ctx.frame.now;
+  while (ctx.frame.now - startWait <= RELEASE_TIMEOUT_MS) {
+    InputState s = getInputState(ctx);
+    if (s.buttonA || s.buttonB) {
+      co_await nextFrame();
+      continue;
     }
-    
-    Delay(50);
+    // Wait extra time to ensure clean release, then double-check
+    co_await sleepFor(RELEASE_SETTLE_MS);
+    s = getInputState(ctx);
+    if (!s.buttonA && !s.buttonB) break;
   }
-  
+
   // Reset all button states after release
-  prevAState = prevBState = false;
-  currentAState = currentBState = false;
-  lastDebounceA = lastDebounceB = Millis();
-  
+  ctx.prevAState = ctx.prevBState = false;
+  ctx.currentAState = ctx.currentBState = false;
+  ctx.lastDebounceA = ctx.lastDebounceB = ctx.frame.now;
+
   // Clear exit sequence flag after cooldown
-  wasInExitSequence = false;
+  ctx.wasInExitSequence = false;
 }
 
 // ---------- Input ----------
-InputState getInputState() {
+InputState getInputState(GameContext& ctx) {
   InputState s;
   
   // Read current button states
-  currentAState = ButtonPressed(Button::BTN_A);
-  currentBState = ButtonPressed(Button::BTN_B);
+  ctx.currentAState = ctx.dev.ButtonPressed(Button::BTN_A);
+  ctx.currentBState = ctx.dev.ButtonPressed(Button::BTN_B);
   
-  s.buttonA = currentAState;
-  s.buttonB = currentBState;
+  s.buttonA = ctx.currentAState;
+  s.buttonB = ctx.currentBState;
   s.both    = s.buttonA && s.buttonB;
   return s;
 }
 
 // Edge-triggered button press detection
-bool getButtonAPressed() {
-  return buttonPressedRising(currentAState, prevAState, lastDebounceA);
+bool getButtonAPressed(GameContext& ctx) {
+  return buttonPressedRising(ctx, ctx.currentAState, ctx.prevAState, ctx.lastDebounceA);
 }
 
-bool getButtonBPressed() {
-  return buttonPressedRising(currentBState, prevBState, lastDebounceB);
+bool getButtonBPressed(GameContext& ctx) {
+  return buttonPressedRising(ctx, ctx.currentBState, ctx.prevBState, ctx.lastDebounceB);
 }
 
 // ---------- UI ----------
-void drawStatusBar(const char* gameName, int currentScore, int highScore) {
-  FillRect(0, 0, SCREEN_WIDTH, STATUS_BAR_HEIGHT, false);
-  DrawText(0, 2, "HSC:", 1, true);
+// Everything that can draw over the status bar goes through here, so
+// drawStatusBar() knows its cached contents are gone
+static void clearScreen(GameContext& ctx) {
+  ctx.dev.ClearDisplay();
+  ctx.bar.valid = false;
+}
+
+// Redrawn only when the numbers change: clearing and redrawing the same
+// bar would count as a change and cost a Present() transfer
+void drawStatusBar(GameContext& ctx, const char* gameName, int currentScore, int highScore) {
+  BLOOP_TRACE_SCOPE("drawStatusBar");
+  Device& dev = ctx.dev;
+  if (ctx.bar.valid && ctx.bar.score == currentScore && ctx.bar.high == highScore) return;
+  ctx.bar = { true, currentScore, highScore };
+  dev.FillRect(0, 0, SCREEN_WIDTH, STATUS_BAR_HEIGHT, false);
+  dev.DrawText(0, 2, "HSC:", 1, true);
   char buf[16]; std::snprintf(buf, sizeof(buf), "%d", highScore);
-  DrawText(24, 2, buf, 1, true);
+  dev.DrawText(24, 2, buf, 1, true);
 
-  DrawText(50, 2, "Scr:", 1, true);
+  dev.DrawText(50, 2, "Scr:", 1, true);
   std::snprintf(buf, sizeof(buf), "%d", currentScore);
-  DrawText(75, 2, buf, 1, true);
+  dev.DrawText(75, 2, buf, 1, true);
 
-  DrawText(110, 2, "BAT", 1, true);
+  dev.DrawText(110, 2, "BAT", 1, true);
 }
 
-void drawStatusBarMenu() {
-  FillRect(0, 0, SCREEN_WIDTH, STATUS_BAR_HEIGHT, false);
-  DrawText(48, 2, "BLOOP", 1, true);
-  DrawText(110, 2, "BAT",  1, true);
-  Present();
+void drawStatusBarMenu(GameContext& ctx) {
+  BLOOP_TRACE_SCOPE("drawStatusBarMenu");
+  Device& dev = ctx.dev;
+  ctx.bar.valid = false;
+  dev.FillRect(0, 0, SCREEN_WIDTH, STATUS_BAR_HEIGHT, false);
+  dev.DrawText(48, 2, "BLOOP", 1, true);
+  dev.DrawText(110, 2, "BAT",  1, true);
+  dev.Present();
 }
 
-void showExitHoldBar(float progress) {
+void showExitHoldBar(GameContext& ctx, float progress) {
+  BLOOP_TRACE_SCOPE("showExitHoldBar");
+  Device& dev = ctx.dev;
   if (progress < 0) progress = 0;
   if (progress > 1) progress = 1;
   int w = static_cast<int>(SCREEN_WIDTH * progress);
-  FillRect(0, SCREEN_HEIGHT - 2, SCREEN_WIDTH, 2, false);
-  DrawLine(0, SCREEN_HEIGHT - 1, w, SCREEN_HEIGHT - 1, true);
-  Present();
+  // Cleared around the line rather than under it, so a bar that has not
+  // grown writes nothing new
+  dev.FillRect(0, SCREEN_HEIGHT - 2, SCREEN_WIDTH, 1, false);
+  dev.DrawLine(0, SCREEN_HEIGHT - 1, w, SCREEN_HEIGHT - 1, true);
+  dev.FillRect(w + 1, SCREEN_HEIGHT - 1, SCREEN_WIDTH - w - 1, 1, false);
+  dev.Present();
+}
+
+Flow holdToExit(GameContext& ctx) {
+  uint64_t start = ctx.frame.now;
+  while (getInputState(ctx).both) {
+    float prog = (float)(ctx.frame.now - start) / EXIT_HOLD_MS;
+    if (prog >= 1.0f) {
+      ctx.exitReq = true;
+      co_return;
+    }
+    showExitHoldBar(ctx, prog);
+    co_await nextFrame();
+  }
 }
 
-void clearPlayfield() {
-  FillRect(0, STATUS_BAR_HEIGHT, SCREEN_WIDTH, PLAYFIELD_HEIGHT, false);
+void clearPlayfield(GameContext& ctx) {
+  BLOOP_TRACE_SCOPE("clearPlayfield");
+  ctx.dev.FillRect(0, STATUS_BAR_HEIGHT, SCREEN_WIDTH, PLAYFIELD_HEIGHT, false);
 }
 
-void showGameOver(const char* gameName, int score, int highScore) {
-  clearPlayfield();
-  drawStatusBar(gameName, score, highScore);
-  DrawText(30, STATUS_BAR_HEIGHT + 5,  "Game Over", 1, true);
+void showGameOver(GameContext& ctx, const char* gameName, int score, int highScore) {
+  BLOOP_TRACE_SCOPE("showGameOver");
+  Device& dev = ctx.dev;
+  clearPlayfield(ctx);
+  drawStatusBar(ctx, gameName, score, highScore);
+  dev.DrawText(30, STATUS_BAR_HEIGHT + 5,  "Game Over", 1, true);
   char buf[32];
   std::snprintf(buf, sizeof(buf), "Score: %d", score);
-  DrawText(20, STATUS_BAR_HEIGHT + 20, buf, 1, true);
+  dev.DrawText(20, STATUS_BAR_HEIGHT + 20, buf, 1, true);
   std::snprintf(buf, sizeof(buf), "HighScore: %d", highScore);
-  DrawText(20, STATUS_BAR_HEIGHT + 35, buf, 1, true);
-  Present();
+  dev.DrawText(20, STATUS_BAR_HEIGHT + 35, buf, 1, true);
+  dev.Present();
+}
+
+void showGetReady(GameContext& ctx, const char* gameName, const char* instructions) {
+  BLOOP_TRACE_SCOPE("showGetReady");
+  Device& dev = ctx.dev;
+  clearPlayfield(ctx);
+  drawStatusBar(ctx, gameName, 0, getHighScore(ctx, ctx.activeGame));
+  dev.DrawText(35, STATUS_BAR_HEIGHT + 15, "Get Ready...", 1, true);
+  if (instructions) dev.DrawText(15, STATUS_BAR_HEIGHT + 30, instructions, 1, true);
+  dev.Present();
+}
+
+// ---------- Background tasks ----------
+static uint32_t loadHighScores(void* arg) {
+  GameContext& ctx = *static_cast<GameContext*>(arg);
+  int v;
+  for (int i = 0; i < static_cast<int>(GameID::COUNT); ++i) {
+    if (ctx.dev.StorageGet(gHighScoreKeys[i], v) && v >= 0 && v < 99999) { // Sanity check
+      ctx.high[i] = v;
+    }
+  }
+  return 0;
+}
+
+static uint32_t commitStorage(void* arg) {
+  static_cast<GameContext*>(arg)->dev.StorageCommit();
+  return 0;
+}
+
+// The flash write waits for spare time, at the latest a few seconds. Post
+// from quiet screens only: a game frame has no room for it.
+static void postStorageCommit(GameContext& ctx) {
+  ctx.tasks.Post(commitStorage, &ctx, TaskScheduler::NORMAL, STORAGE_COMMIT_COST_MS,
+                 ctx.frame.now, ctx.frame.now + STORAGE_COMMIT_MAX_WAIT_MS);
+}
+
+// Frame rate and overruns over the last window
+static uint32_t sampleDiagnostics(void* arg) {
+  GameContext& ctx = *static_cast<GameContext*>(arg);
+  FrameDiag& d = ctx.diag;
+  uint64_t now = ctx.dev.Millis();
+  uint64_t span = now - d.windowStart;
+  if (span > 0) d.fps = static_cast<uint16_t>((ctx.frame.index - d.windowIndex) * 1000ull / span);
+  d.lateInWindow = static_cast<uint16_t>(d.lateFrames - d.windowLate);
+  d.windowIndex = ctx.frame.index;
+  d.windowLate = d.lateFrames;
+  d.windowStart = now;
+  return DIAG_PERIOD_MS;
 }
 
-void showGetReady(const char* gameName, const char* instructions) {
-  clearPlayfield();
-  int hs = (gameName && std::strcmp(gameName, "SNAKE")==0) ? getHighScore(GameID::SNAKE) : getHighScore(GameID::PONG);
-  drawStatusBar(gameName, 0, hs);
-  DrawText(35, STATUS_BAR_HEIGHT + 15, "Get Ready...", 1, true);
-  if (instructions) DrawText(15, STATUS_BAR_HEIGHT + 30, instructions, 1, true);
-  Present();
+// How full the session's fixed arenas have been; on hardware this is the
+// place to see how close BLOOP_FLOW_SLOTS / BLOOP_FLOW_SLOT_BYTES are
+static void logArenas(GameContext& ctx) {
+  const FlowArena& f = ctx.flows;
+  const PresentStats& p = ctx.dev.Presents();
+  char line[128];
+  int n = std::snprintf(line, sizeof(line), "arena: flows %d of %d slots, largest frame %d of %d B, %lu failed; games %u B",
+                        f.HighWater(), FlowArena::SLOTS, f.Largest(), FlowArena::SLOT_BYTES,
+                        static_cast<unsigned long>(f.Failures()), static_cast<unsigned>(GameStates::BYTES));
+  if (p.listCapacity && n > 0 && n < static_cast<int>(sizeof(line)))
+    std::snprintf(line + n, sizeof(line) - n, "; display list %d of %d B, %lu dropped",
+                  p.listHighWater, p.listCapacity, static_cast<unsigned long>(p.listOverflows));
+  ctx.dev.Log(line);
+}
+
+const char* gameName(GameID id) {
+  return gGameNames[static_cast<int>(id)];
 }
 
 // ---------- High scores (persist to localStorage on web) ----------
-int getHighScore(GameID id) {
-  return gHigh[static_cast<int>(id)];
+int getHighScore(const GameContext& ctx, GameID id) {
+  return ctx.high[static_cast<int>(id)];
 }
 
-void considerHighScore(GameID id, int score) {
+void considerHighScore(GameContext& ctx, GameID id, int score) {
+  // Never compare against scores that are not loaded yet
+  if (ctx.tasks.Pending(loadHighScores, &ctx)) {
+    ctx.tasks.Cancel(loadHighScores, &ctx);
+    loadHighScores(&ctx);
+  }
   int idx = static_cast<int>(id);
-  if (score > gHigh[idx]) {
-    gHigh[idx] = score;
-    if (id == GameID::SNAKE) StorageSet("hs_snake", score);
-    if (id == GameID::PONG)  StorageSet("hs_pong",  score);
+  if (score > ctx.high[idx]) {
+    ctx.high[idx] = score;
+    ctx.dev.StorageSet(gHighScoreKeys[idx], score);
+    postStorageCommit(ctx);
   }
 }
 
+// ---------- Suspend snapshot ----------
+int writeSnapshot(GameContext& ctx, uint8_t* out, int capacity) {
+  SnapWriter w(out, capacity);
+  w.U8(SNAPSHOT_MAGIC);
+  w.U8(SNAPSHOT_VERSION);
+  w.U8(static_cast<uint8_t>(ctx.activeGame));
+  w.U8(0);                                    // payload length, below
+  w.U16(static_cast<uint32_t>(ctx.currentScore));
+  w.U32(ctx.dev.RandomState());
+  w.U8(static_cast<uint32_t>(ctx.menuIndex));
+  bool ok = false;
+  if (const SnakeState* s = ctx.games.Get<SnakeState>()) ok = ctx.activeGame == GameID::SNAKE && snapshotSnake(*s, w);
+  if (const PongState* p = ctx.games.Get<PongState>())   ok = ctx.activeGame == GameID::PONG && snapshotPong(*p, w);
+  int payload = w.Size() - SNAPSHOT_HEADER;
+  if (!ok || !w.Ok() || payload > 255) return 0;
+  out[3] = static_cast<uint8_t>(payload);
+  w.U16(snapshotSum(out, w.Size()));
+  return w.Ok() ? w.Size() : 0;
+}
+
+bool readSnapshot(GameContext& ctx, const uint8_t* data, int n) {
+  if (n < SNAPSHOT_HEADER + SNAPSHOT_TRAILER || data[0] != SNAPSHOT_MAGIC || data[1] != SNAPSHOT_VERSION) return false;
+  int payload = data[3];
+  if (n != SNAPSHOT_HEADER + payload + SNAPSHOT_TRAILER) return false;
+  SnapReader sum(data + n - SNAPSHOT_TRAILER, SNAPSHOT_TRAILER);
+  if (sum.U16() != snapshotSum(data, n - SNAPSHOT_TRAILER)) return false;
+
+  SnapReader r(data + SNAPSHOT_HEADER, payload);
+  int score = static_cast<int>(r.U16());
+  uint32_t rng = r.U32();
+  int menu = static_cast<int>(r.U8());
+  if (!r.Ok() || menu >= MENU_COUNT) return false;
+  GameID game = static_cast<GameID>(data[2]);
+  bool ok = game == GameID::SNAKE ? restoreSnake(ctx, r)
+          : game == GameID::PONG  ? restorePong(ctx, r)
+          : false;
+  if (!ok) return false;
+
+  ctx.activeGame = game;
+  ctx.currentScore = score;
+  ctx.menuIndex = menu;
+  ctx.dev.SetRandomState(rng);
+  ctx.gameInited = true;
+  ctx.exitReq = ctx.gameOver = false;
+  ctx.state = SysState::IN_GAME;
+  return true;
+}
+
+// Leaving a game keeps it for the next boot. Games that cannot be saved
+// (Big Snake) leave no snapshot, so an older one never comes back.
+static void suspendGame(GameContext& ctx) {
+  uint8_t snap[SNAPSHOT_BYTES];
+  int n = writeSnapshot(ctx, snap, sizeof(snap));
+  ctx.dev.StorageSetSnapshot(n ? snap : nullptr, n);
+  postStorageCommit(ctx);
+}
+
+// The suspended game is gone once another one starts or this one ends.
+// commit: also write that out (quiet screens only; see postStorageCommit)
+static void discardSnapshot(GameContext& ctx, bool commit) {
+  uint8_t snap[SNAPSHOT_BYTES];
+  if (ctx.dev.StorageGetSnapshot(snap, sizeof(snap)) == 0) return;
+  ctx.dev.StorageSetSnapshot(nullptr, 0);
+  if (commit) postStorageCommit(ctx);
+}
+
 // ---------- Menu ----------
-static void showMenu() {
-  ClearDisplay();
-  drawStatusBarMenu();
-  for (int i = 0; i < gMenuCount; ++i) {
+static void showMenu(GameContext& ctx) {
+  BLOOP_TRACE_SCOPE("showMenu");
+  Device& dev = ctx.dev;
+  clearScreen(ctx);
+  drawStatusBarMenu(ctx);
+  for (int i = 0; i < MENU_COUNT; ++i) {
     int y = STATUS_BAR_HEIGHT + 5 + i * 10;
-    DrawText(0,  y, (i == gMenuIndex) ? "> " : "  ", 1, true);
-    DrawText(12, y, gMenuItems[i], 1, true);
+    dev.DrawText(0,  y, (i == ctx.menuIndex) ? "> " : "  ", 1, true);
+    dev.DrawText(12, y, gMenuItems[i], 1, true);
   }
-  Present();
+  dev.Present();
 }
 
 // ---------- Boot ----------
-static void showBootAnimationFrame() {
-  unsigned long t = Millis() - gBootStart;
-  
-  // Multi-phase animation
+// Which of the boot pictures drawBootLogo() shows at t
+static int bootLogoPicture(uint64_t t) {
+  if (t < 800)  return 0;
+  if (t < 1200) return ((t - 800) / 100) % 2 == 0 ? 1 : 2;
+  return 3;
+}
+
+static void drawBootLogo(GameContext& ctx, uint64_t t) {
+  BLOOP_TRACE_SCOPE("drawBootLogo");
+  Device& dev = ctx.dev;
+  int centerX = (SCREEN_WIDTH - (5 * 6 * 2)) / 2;  // where the scale-2 "BLOOP" text sat
+  clearScreen(ctx);
   if (t < 800) {
-    // Phase 1: Sliding text
-    int textWidth = 5 * 6 * 2; // "BLOOP" is 5 chars * 6 pixels * scale 2
-    int maxOffset = SCREEN_WIDTH + textWidth;
-    int offset = (int)((t * maxOffset) / 800) - textWidth;
-    
-    ClearDisplay();
-    if (offset < SCREEN_WIDTH) {
-      DrawText(offset, 25, "BLOOP", 2, true);
-    }
-    Present();
+    // Hold in the centre (redrawn: the scroll only approximated the distance)
+    dev.DrawSprite(centerX, BOOT_LOGO_Y, Assets::LOGO);
   } else if (t < 1200) {
     // Phase 2: Centered with blinking
-    ClearDisplay();
     bool blink = ((t - 800) / 100) % 2 == 0; // Blink every 100ms
     if (blink) {
-      int centerX = (SCREEN_WIDTH - (5 * 6 * 2)) / 2;
-      DrawText(centerX, 25, "BLOOP", 2, true);
+      dev.DrawSprite(centerX, BOOT_LOGO_Y, Assets::LOGO);
     }
-    Present();
   } else {
     // Phase 3: Final display with version
-    ClearDisplay();
-    int centerX = (SCREEN_WIDTH - (5 * 6 * 2)) / 2;
-    DrawText(centerX, 20, "BLOOP", 2, true);
-    DrawText(centerX + 20, 40, "v1.0", 1, true);
-    Present();
+    dev.DrawSprite(centerX, 20, Assets::LOGO);
+    dev.DrawText(centerX + 20, 40, "v1.0", 1, true);
+  }
+  dev.Present();
+}
+
+// Boot animation, then the menu. A warm start joins it near the end.
+static Flow bootFlow(GameContext& ctx) {
+  Device& dev = ctx.dev;
+  auto t = [&ctx] { return ctx.frame.now - ctx.bootStart; };
+  int centerX = (SCREEN_WIDTH - (5 * 6 * 2)) / 2;
+
+  // Phase 1: the logo is drawn once and the panel scrolls it into place
+  if (t() < BOOT_SLIDE_COLS * SCROLL_MS_PER_COLUMN) {
+    clearScreen(ctx);
+    dev.DrawSprite(centerX - BOOT_SLIDE_COLS, BOOT_LOGO_Y, Assets::LOGO);
+    dev.Present();
+    dev.ScrollStart(BOOT_LOGO_Y / 8, (BOOT_LOGO_Y + Assets::LOGO.h - 1) / 8, true);
+    ctx.scrolling = true;
+    co_await nextFrame();
+    while (t() < BOOT_SLIDE_COLS * SCROLL_MS_PER_COLUMN) {
+      dev.Present();  // no-op on the panel; software backends shift here
+      co_await nextFrame();
+    }
+    dev.ScrollStop();
+    ctx.scrolling = false;
+  }
+
+  // Redrawn when the picture changes; in between, Present() has nothing to send
+  int drawn = -1;
+  while (t() < BOOT_MS) {
+    if (bootLogoPicture(t()) != drawn) {
+      drawn = bootLogoPicture(t());
+      drawBootLogo(ctx, t());
+    } else {
+      dev.Present();
+    }
+    co_await nextFrame();
   }
+
+  ctx.state = SysState::MENU;
+  logArenas(ctx);
+  co_await buttonsReleased(ctx);  // Ensure clean transition
+  showMenu(ctx);
 }
 
 // ---------- Sleep (web mock) ----------
-static void sleepModeWeb() {
-  ClearDisplay();
-  DrawText(20, 25, "Sleeping...", 1, true);
-  Present();
-  Delay(500);
+static Flow sleepFlow(GameContext& ctx) {
+  Device& dev = ctx.dev;
+  clearScreen(ctx);
+  dev.DrawText(20, 25, "Sleeping...", 1, true);
+  dev.Present();
+  // Power may go: the suspended game and scores are written now
+  ctx.tasks.Cancel(commitStorage, &ctx);
+  dev.StorageCommit();
+  co_await sleepFor(SLEEP_MS);
+  ctx.menuIndex = 0;
+  showMenu(ctx);
 }
 
-// ---------- Manager ----------
-void initGameManager() {
-  // Initialize high scores to 0 first
-  gHigh[static_cast<int>(GameID::SNAKE)] = 0;
-  gHigh[static_cast<int>(GameID::PONG)] = 0;
-  
-  // Then try to load from storage
-  int v;
-  if (StorageGet("hs_snake", v) && v >= 0 && v < 99999) { // Sanity check
-    gHigh[static_cast<int>(GameID::SNAKE)] = v;
+// ---------- Transitions ----------
+// The list slides out on the panel before the game starts
+static Flow menuOutFlow(GameContext& ctx) {
+  ctx.dev.ScrollStart(STATUS_BAR_HEIGHT / 8, SCREEN_HEIGHT / 8 - 1, true);
+  ctx.scrolling = true;
+  ctx.state = SysState::MENU_OUT;
+  uint64_t until = ctx.frame.now + MENU_OUT_MS;
+  co_await nextFrame();
+  while (ctx.frame.now < until) {
+    ctx.dev.Present();
+    co_await nextFrame();
   }
-  if (StorageGet("hs_pong", v) && v >= 0 && v < 99999) { // Sanity check
-    gHigh[static_cast<int>(GameID::PONG)] = v;
+  ctx.dev.ScrollStop();
+  ctx.scrolling = false;
+  ctx.state = SysState::IN_GAME;
+  co_await buttonsReleased(ctx);  // Prevent immediate input in game
+}
+
+// The game's state goes as soon as it is over; its score is already in ctx.
+// The screen is cleared first: in page mode the display list holds pointers
+// into the state (Snake's tile map) until it is cleared. Nothing is
+// presented before the next screen is drawn, so this is not seen.
+static void endGame(GameContext& ctx) {
+  ctx.intro = Flow();
+  ctx.exitHold = Flow();
+  clearScreen(ctx);
+  ctx.games.Destroy();
+}
+
+static Flow exitFlow(GameContext& ctx) {
+  suspendGame(ctx);
+  endGame(ctx);
+  // Mark that we're exiting from an exit sequence
+  ctx.wasInExitSequence = true;
+  ctx.state = SysState::MENU;
+  co_await buttonsReleased(ctx);  // Critical: wait for button release before menu
+  showMenu(ctx);
+}
+
+static Flow gameOverFlow(GameContext& ctx) {
+  endGame(ctx);
+  discardSnapshot(ctx, true);
+  considerHighScore(ctx, ctx.activeGame, ctx.currentScore);
+  ctx.gameOverName  = gameName(ctx.activeGame);
+  ctx.gameOverScore = ctx.currentScore;
+  showGameOver(ctx, ctx.gameOverName, ctx.gameOverScore, getHighScore(ctx, ctx.activeGame));
+  uint64_t until = ctx.frame.now + GAME_OVER_MS;
+  ctx.state = SysState::GAME_OVER;
+  co_await buttonsReleased(ctx);  // Ensure clean transition
+  co_await sleepUntil(until);
+  ctx.state = SysState::MENU;
+  co_await buttonsReleased(ctx);
+  showMenu(ctx);
+}
+
+// Every system flow starts here. One the arena could not frame (no free
+// slot, or a frame larger than a slot) is empty, and the console would wait
+// on it for ever, in BOOT at power-on: it is logged and the console drops
+// to the menu instead.
+static void startSys(GameContext& ctx, Flow flow) {
+  ctx.sys = std::move(flow);
+  if (ctx.sys.Running()) return;
+  ctx.dev.Log("flow arena full: system flow not started, back to the menu");
+  logArenas(ctx);
+  if (ctx.scrolling) {
+    ctx.dev.ScrollStop();
+    ctx.scrolling = false;
   }
+  endGame(ctx);
+  ctx.state = SysState::MENU;
+  showMenu(ctx);
+}
 
-  gState = SysState::BOOT;
-  gBootStart = Millis();
-  gMenuIndex = 0;
-  
-  // Reset button states and exit tracking
-  prevAState = prevBState = false;
-  currentAState = currentBState = false;
-  wasInExitSequence = false;
-  exitSequenceEndTime = 0;
-  lastFrameTime = Millis();
+// A display list that ran out of room dropped draw calls (page mode), so the
+// screen is short of them, an XOR erase as much as a draw. The first drop is
+// logged; the screen is then drawn again from a clear as soon as nothing
+// else owns it: the menu, or the game between its Get Ready and exit hold.
+// A system flow draws its own screen from a clear anyway.
+static void repaintAfterDrops(GameContext& ctx) {
+  uint32_t drops = ctx.dev.Presents().listOverflows;
+  if (drops != ctx.listDropsSeen) {
+    if (ctx.listDropsSeen == 0) {
+      ctx.dev.Log("display list full: draw calls dropped, repainting the screen");
+      logArenas(ctx);
+    }
+    ctx.listDropsSeen = drops;
+    ctx.repaint = true;
+  }
+  if (!ctx.repaint || ctx.sys.Running()) return;
+  if (ctx.state == SysState::MENU) {
+    showMenu(ctx);
+  } else if (ctx.state == SysState::IN_GAME && !ctx.intro.Running() && !ctx.exitHold.Running()) {
+    clearScreen(ctx);   // and the status bar with it
+    if (ctx.games.Holds<PongState>())     ctx.games.As<PongState>().drawnValid = false;
+    if (ctx.games.Holds<SnakeState>())    ctx.games.As<SnakeState>().tiles.Invalidate();
+    if (ctx.games.Holds<BigSnakeState>()) ctx.games.As<BigSnakeState>().tiles.Invalidate();
+  } else {
+    return;
+  }
+  ctx.repaint = false;
 }
 
-void runGameLoop() {
-  // Update input state first
-  InputState s = getInputState();
+// ---------- Manager ----------
+void initGameManager(GameContext& ctx) {
+  Device& dev = ctx.dev;
+  // Initialize high scores to 0 first
+  for (int& h : ctx.high) h = 0;
+
+  ctx.state = SysState::BOOT;
+  ctx.frame = FrameTime{};
+  ctx.frame.now = dev.Millis();
+  ctx.bootStart = ctx.frame.now;
+  if (dev.HasSaveData()) ctx.bootStart -= WARM_BOOT_SKIP_MS;
+  ctx.menuIndex = 0;
+  ctx.scrolling = false;
   
-  if (gState == SysState::BOOT) {
-    if (Millis() - gBootStart < 2000) {  // Extended boot time for better animation
-      showBootAnimationFrame(); 
-      limitFrameRate(true);  // Allow faster updates for smooth animation
-      return; 
-    }
-    gState = SysState::MENU; 
-    waitForButtonRelease();  // Ensure clean transition
-    showMenu(); 
-    limitFrameRate();
+  // Reset button states and exit tracking
+  ctx.prevAState = ctx.prevBState = false;
+  ctx.currentAState = ctx.currentBState = false;
+  ctx.wasInExitSequence = false;
+  ctx.exitSequenceEndTime = 0;
+  ctx.lastFrameTime = ctx.frame.now;
+  ctx.diag = FrameDiag{};
+  ctx.diag.windowStart = ctx.frame.now;
+  ctx.tasks.Post(sampleDiagnostics, &ctx, TaskScheduler::IDLE, 0, ctx.frame.now + DIAG_PERIOD_MS);
+
+  // A suspended game resumes at once: no boot animation, no Get Ready. The
+  // snapshot is only written when a game is left (the hold, or sleep) and
+  // stays until the next leave or the game ending, so a power cut mid-game
+  // comes back to where it was last left, or to the menu if it never was.
+  // Nothing writes it during play: a commit is a flash sector write a game
+  // frame has no room for, and it would wear the flash.
+  uint8_t snap[SNAPSHOT_BYTES];
+  int n = dev.StorageGetSnapshot(snap, sizeof(snap));
+  if (n > 0 && readSnapshot(ctx, snap, n)) {
+    loadHighScores(&ctx);   // the first frame's status bar shows them
+    ctx.diag.resumed = true;
+    logArenas(ctx);
     return;
   }
 
-  if (gState == SysState::GAME_OVER) {
-    if (Millis() < gGameOverUntil) {
-      limitFrameRate();
-      return;
-    }
-    gState = SysState::MENU; 
-    waitForButtonRelease();  // Ensure clean transition
-    showMenu(); 
-    limitFrameRate();
+  startSys(ctx, bootFlow(ctx));
+  // Then load the high scores in the first frame's spare time
+  ctx.tasks.Post(loadHighScores, &ctx, TaskScheduler::URGENT, 1);
+}
+
+void runGameLoop(GameContext& ctx) {
+  BLOOP_TRACE_SCOPE("runGameLoop");
+  beginFrame(ctx);
+  const uint64_t now = ctx.frame.now;
+  // Update input state first
+  getInputState(ctx);
+  repaintAfterDrops(ctx);
+
+  // A frame that resumes the system flow belongs to it; the boot animation
+  // runs at the faster rate
+  if (ctx.sys.Running()) {
+    ctx.sys.Resume(now);
+    limitFrameRate(ctx, ctx.state == SysState::BOOT);
     return;
   }
 
-  if (gState == SysState::MENU) {
+  if (ctx.state == SysState::MENU) {
     // Check if we're still in exit cooldown
-    if (wasInExitSequence && (Millis() - exitSequenceEndTime) < EXIT_COOLDOWN_MS) {
-      limitFrameRate();
+    if (ctx.wasInExitSequence && (now - ctx.exitSequenceEndTime) < EXIT_COOLDOWN_MS) {
+      limitFrameRate(ctx);
       return;
     }
     
-    if (getButtonBPressed()) {
-      gMenuIndex = (gMenuIndex + 1) % gMenuCount; 
-      showMenu(); 
-      limitFrameRate();
+    if (getButtonBPressed(ctx)) {
+      ctx.menuIndex = (ctx.menuIndex + 1) % MENU_COUNT; 
+      showMenu(ctx); 
+      limitFrameRate(ctx);
       return;
     }
     
-    if (getButtonAPressed()) {
-      const char* pick = gMenuItems[gMenuIndex];
+    if (getButtonAPressed(ctx)) {
+      const char* pick = gMenuItems[ctx.menuIndex];
       if (std::strcmp(pick, "3.Sleep") == 0) {
-        sleepModeWeb(); 
-        gMenuIndex = 0; 
-        showMenu(); 
-        limitFrameRate();
+        startSys(ctx, sleepFlow(ctx));
+        ctx.sys.Resume(now);
+        limitFrameRate(ctx);
         return;
       }
-      gActiveGame = (std::strcmp(pick, "1.Snake")==0) ? GameID::SNAKE : GameID::PONG;
-      gGameInited = false; 
-      gCurrentScore = 0; 
-      gExitReq = gGameOver = false;
-      gState = SysState::IN_GAME;
-      waitForButtonRelease();  // Prevent immediate input in game
-      limitFrameRate();
+      ctx.activeGame = std::strcmp(pick, "1.Snake") == 0     ? GameID::SNAKE
+                     : std::strcmp(pick, "4.Big Snake") == 0 ? GameID::BIG_SNAKE
+                     : GameID::PONG;
+      if (ctx.activeGame == GameID::SNAKE) ctx.games.Emplace<SnakeState>();
+      else if (ctx.activeGame == GameID::BIG_SNAKE) ctx.games.Emplace<BigSnakeState>();
+      else ctx.games.Emplace<PongState>();
+      ctx.gameInited = false; 
+      ctx.currentScore = 0; 
+      ctx.exitReq = ctx.gameOver = false;
+      discardSnapshot(ctx, false);   // written out with the next commit
+      startSys(ctx, menuOutFlow(ctx));
+      ctx.sys.Resume(now);
+      limitFrameRate(ctx);
       return;
     }
     
-    limitFrameRate();
+    limitFrameRate(ctx);
     return;
   }
 
-  if (gState == SysState::IN_GAME) {
-    if (!gGameInited) { 
-      if (gActiveGame == GameID::SNAKE) startSnake(); 
-      else startPong(); 
-      gGameInited = true; 
+  if (ctx.state == SysState::IN_GAME) {
+    if (!ctx.gameInited) { 
+      if (ctx.activeGame == GameID::PONG) startPong(ctx); 
+      else startSnake(ctx); 
+      ctx.gameInited = true; 
     }
     
-    bool ok = (gActiveGame == GameID::SNAKE)
-              ? stepSnake(gCurrentScore, gExitReq, gGameOver)
-              : stepPong (gCurrentScore, gExitReq, gGameOver);
-
-    if (!ok || gExitReq) { 
-      // Mark that we're exiting from an exit sequence
-      wasInExitSequence = true;
-      gState = SysState::MENU; 
-      waitForButtonRelease();  // Critical: wait for button release before menu
-      showMenu(); 
-      limitFrameRate();
+    bool ok = (ctx.activeGame == GameID::PONG)
+              ? stepPong (ctx, ctx.currentScore, ctx.exitReq, ctx.gameOver)
+              : stepSnake(ctx, ctx.currentScore, ctx.exitReq, ctx.gameOver);
+
+    if (!ok || ctx.exitReq) { 
+      startSys(ctx, exitFlow(ctx));
+      ctx.sys.Resume(now);
+      limitFrameRate(ctx);
       return; 
     }
     
-    if (gGameOver) {
-      considerHighScore(gActiveGame, gCurrentScore);
-      gGameOverName  = (gActiveGame == GameID::SNAKE) ? "SNAKE" : "PONG";
-      gGameOverScore = gCurrentScore;
-      showGameOver(gGameOverName, gGameOverScore, getHighScore(gActiveGame));
-      gGameOverUntil = Millis() + 1500;
-      gState = SysState::GAME_OVER;
-      waitForButtonRelease();  // Ensure clean transition
-      limitFrameRate();
+    // Past the Get Ready screen (which a resume skips)
+    if (ctx.diag.firstPlayMs == FrameDiag::NOT_YET && !ctx.intro.Running()) {
+      ctx.diag.firstPlayMs = ctx.dev.Millis();
+      char line[48];
+      std::snprintf(line, sizeof(line), "first play %lu ms (%s)",
+                    static_cast<unsigned long>(ctx.diag.firstPlayMs), ctx.diag.resumed ? "resumed" : "cold boot");
+      ctx.dev.Log(line);
+    }
+
+    if (ctx.gameOver) {
+      startSys(ctx, gameOverFlow(ctx));
+      ctx.sys.Resume(now);
+      limitFrameRate(ctx);
       return;
     }
     
-    limitFrameRate();
+    limitFrameRate(ctx);
     return;
   }
 }
@@ -1,8 +1,16 @@
 #pragma once
 #include "platform.h"
+#include "flow.h"
+#include "tasks.h"
+#include "game_arena.h"
+#include "SnakeGame.h"
+#include "Pong.h"
 #include <cstdint>
 
-enum class GameID : uint8_t { SNAKE = 0, PONG = 1, COUNT = 2 };
+enum class GameID : uint8_t { SNAKE = 0, PONG = 1, BIG_SNAKE = 2, COUNT = 3 };
+
+// Entries in the main menu (the games and Sleep)
+constexpr int MENU_COUNT = 4;
 
 struct InputState {
   bool buttonA = false;
@@ -10,28 +18,126 @@ struct InputState {
   bool both    = false;
 };
 
-void initGameManager();
-void runGameLoop();
+// State of every game, sharing one block: only the game being played exists
+using GameStates = GameArena<SnakeState, PongState, BigSnakeState>;
+
+enum class SysState : uint8_t { BOOT, MENU, MENU_OUT, IN_GAME, GAME_OVER };
+
+// Clock snapshot taken once at the top of runGameLoop(). Games and UI
+// helpers read this instead of calling Millis(), so a frame sees one time.
+struct FrameTime {
+  uint64_t now   = 0;  // ms, monotonic
+  uint32_t dt    = 0;  // ms since the previous frame's snapshot
+  uint32_t index = 0;  // frames run by this session
+};
+
+// Frame-health counters; the window figures are refreshed once a second by
+// a background task, off the frame path
+struct FrameDiag {
+  uint32_t lateFrames = 0;     // frames that overran TARGET_FRAME_MS, total
+  uint16_t fps = 0;            // over the last window
+  uint16_t lateInWindow = 0;
+  uint32_t windowIndex = 0;    // frame.index / lateFrames / time at the window start
+  uint32_t windowLate = 0;
+  uint64_t windowStart = 0;
+  static constexpr uint64_t NOT_YET = ~0ull;
+  uint64_t firstPlayMs = NOT_YET;  // Millis() when the first game frame was drawn: power-on to play
+  bool     resumed = false;    // this boot restored a suspended game
+};
+
+// Everything one console session owns. Nothing in the game code is
+// file-scope mutable, so any number of sessions can run side by side.
+struct GameContext {
+  explicit GameContext(Platform::Device& device) : dev(device) {}
+
+  Platform::Device& dev;
+  FrameTime         frame;
+
+  int      high[static_cast<int>(GameID::COUNT)] = {};
+  SysState state = SysState::BOOT;
+  uint64_t bootStart = 0;
+  int      menuIndex = 0;
+  bool     scrolling = false;   // a Device scroll is running (boot slide, MENU_OUT)
+
+  GameID   activeGame = GameID::SNAKE;
+  bool     gameInited = false;
+  int      currentScore = 0;
+  bool     exitReq = false;
+  bool     gameOver = false;
+
+  // Button debouncing and edge detection
+  uint64_t lastDebounceA = 0, lastDebounceB = 0;
+  bool prevAState = false, prevBState = false;
+  bool currentAState = false, currentBState = false;
+
+  // Exit state management
+  bool wasInExitSequence = false;
+  uint64_t exitSequenceEndTime = 0;
+
+  // Frame rate limiting
+  uint64_t lastFrameTime = 0;
+
+  // What drawStatusBar() last drew; valid until something draws over it
+  struct StatusBar { bool valid; int score, high; };
+  StatusBar bar = { false, 0, 0 };
+
+  // Draw calls the display list has dropped (PresentStats), as last seen;
+  // a new drop sets repaint until the screen can be drawn again from a clear
+  uint32_t listDropsSeen = 0;
+  bool     repaint = false;
+
+  // GAME_OVER overlay
+  const char* gameOverName  = nullptr;
+  int         gameOverScore = 0;
+
+  // The active game's state, built in place when the game is picked (or
+  // by start*() if nothing is there yet) and destroyed when it ends
+  GameStates games;
+
+  // Coroutine flows (flow.h), framed in this session's arena. While sys runs
+  // (boot, transitions, game over) it owns the frame; the game runs intro
+  // (its Get Ready) and exitHold (both buttons held) inside its own step.
+  FlowArena flows;
+  Flow      sys;
+  Flow      intro;
+  Flow      exitHold;
+
+  // Work that is not part of a frame (storage commits, diagnostics), run in
+  // the time each frame leaves before its deadline
+  TaskScheduler tasks;
+  FrameDiag     diag;
+};
+
+void initGameManager(GameContext& ctx);
+void runGameLoop(GameContext& ctx);
 
 // UI helpers
-void drawStatusBar(const char* gameName, int currentScore, int highScore);
-void drawStatusBarMenu();
-void showExitHoldBar(float progress);
-void clearPlayfield();
-void showGameOver(const char* gameName, int score, int highScore);
-void showGetReady(const char* gameName, const char* instructions = nullptr);
+void drawStatusBar(GameContext& ctx, const char* gameName, int currentScore, int highScore);
+void drawStatusBarMenu(GameContext& ctx);
+void showExitHoldBar(GameContext& ctx, float progress);
+void clearPlayfield(GameContext& ctx);
+void showGameOver(GameContext& ctx, const char* gameName, int score, int highScore);
+void showGetReady(GameContext& ctx, const char* gameName, const char* instructions = nullptr);
+
+// Hold-to-exit while both buttons are down: fills the exit bar, and sets
+// ctx.exitReq once held for the full time; finishes early on release
+Flow holdToExit(GameContext& ctx);
+
+// Suspend snapshot of the running game (snapshot.h), written when the
+// player leaves it and read back by initGameManager() at the next boot.
+// writeSnapshot returns its size, 0 if the game cannot be saved;
+// readSnapshot restores it straight into IN_GAME.
+int  writeSnapshot(GameContext& ctx, uint8_t* out, int capacity);
+bool readSnapshot(GameContext& ctx, const uint8_t* data, int n);
+
+// Display name of a game, as the status bar and Game Over show it
+const char* gameName(GameID id);
 
 // High scores
-int  getHighScore(GameID id);
-void considerHighScore(GameID id, int score);
+int  getHighScore(const GameContext& ctx, GameID id);
+void considerHighScore(GameContext& ctx, GameID id, int score);
 
 // Input
-InputState getInputState();
-bool getButtonAPressed();  // Edge-triggered button press
-bool getButtonBPressed();  // Edge-triggered button press
-
-// Game stepping
-void startSnake();
-void startPong();
-bool stepSnake(int& outScore, bool& exitRequested, bool& gameOver);
-bool stepPong (int& outScore, bool& exitRequested, bool& gameOver);
\ No newline at end of file
+InputState getInputState(GameContext& ctx);
+bool getButtonAPressed(GameContext& ctx);  // Edge-triggered button press
+bool getButtonBPressed(GameContext& ctx);  // Edge-triggered button press
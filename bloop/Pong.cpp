@@ -1,240 +1,304 @@
 #include "Pong.h"
+#include "GameManager.h"
 #include "platform.h"
+#include "assets.h"
+#include "snapshot.h"
 #include <cstdlib>
+#include <cmath>
 #include <algorithm> 
 
 using namespace Platform;
 
 namespace {
-  constexpr int PADDLE_HEIGHT = 10;
-  constexpr int PADDLE_WIDTH  = 2;
-  constexpr int BALL_SIZE     = 2;
-  constexpr int PADDLE_OFFSET = 3;
-  constexpr int PADDLE_SPEED_BASE  = 3;     // Increased from 2 for better responsiveness
-  constexpr unsigned TICK_MS_BASE  = 25;    // Increased from 20ms for smoother gameplay
-
-  struct Paddle { int x,y; };
-  struct Ball { int x,y, vx, vy; };
-
-  static Paddle player, cpu;
-  static Ball   ball;
-  static int    playerScore = 0;
-  static bool   gameActive  = false;
-
-  static unsigned long lastTick = 0;
-  static unsigned long exitHoldStart = 0;
-  static bool          inited = false;
-
-  // Enhanced input handling
-  static bool prevAPressed = false;
-  static bool prevBPressed = false;
-  static unsigned long lastInputTime = 0;
-  static constexpr unsigned INPUT_COOLDOWN_MS = 50;  // Faster input response for Pong
-
-  // Get Ready gating
-  static unsigned long readyUntil = 0;
-  static bool clearedAfterReady = false;
-
-  static void resetGame() {
-    player.x = SCREEN_WIDTH - PADDLE_WIDTH - PADDLE_OFFSET;
-    player.y = STATUS_BAR_HEIGHT + PLAYFIELD_HEIGHT/2 - PADDLE_HEIGHT/2;
-    cpu.x    = PADDLE_OFFSET;
-    cpu.y    = STATUS_BAR_HEIGHT + PLAYFIELD_HEIGHT/2 - PADDLE_HEIGHT/2;
-    ball.x   = SCREEN_WIDTH/2;
-    ball.y   = STATUS_BAR_HEIGHT + PLAYFIELD_HEIGHT/2;
-    ball.vx  = 0; 
-    ball.vy = 0;
-    playerScore = 0;
-    gameActive  = false;
-    lastTick    = Millis();
-    lastInputTime = 0;
-    prevAPressed = prevBPressed = false;
+  constexpr int PADDLE_HEIGHT = PongState::PADDLE_HEIGHT;
+  constexpr int PADDLE_WIDTH  = PongState::PADDLE_WIDTH;
+  constexpr int BALL_SIZE     = PongState::BALL_SIZE;
+  constexpr int PADDLE_OFFSET = PongState::PADDLE_OFFSET;
+  constexpr unsigned INPUT_COOLDOWN_MS = 50;  // Faster input response for Pong
+  constexpr unsigned MAX_CATCHUP_TICKS = 4;   // after a pause, don't fast-forward
+
+  static void resetGame(GameContext& ctx) {
+    PongState& p = ctx.games.As<PongState>();
+    resetPongCourt(p);
+    p.lastTick    = ctx.frame.now;
+    p.lastInputTime = 0;
+    p.prevAPressed = p.prevBPressed = false;
   }
 
-  static void serveBall() {
-    ball.vx = -1;
-    ball.vy = (RandomInt(0,2) == 0) ? 1 : -1;
-    gameActive = true;
+  static void serveBall(GameContext& ctx) {
+    PongState& p = ctx.games.As<PongState>();
+    p.ball.vx = -1;
+    p.ball.vy = (ctx.dev.RandomInt(0,2) == 0) ? 1 : -1;
+    p.gameActive = true;
   }
 
-  static void updateCPU() {
-    if (!gameActive) return;
-    int bc = ball.y + BALL_SIZE/2;
-    int cc = cpu.y + PADDLE_HEIGHT/2;
-    int speed = std::max(1, std::abs(ball.vx));  // Ensure minimum speed
+  static void updateCPU(PongState& p) {
+    if (!p.gameActive) return;
+    int bc = p.ball.y + BALL_SIZE/2;
+    int cc = p.cpu.y + PADDLE_HEIGHT/2;
+    int speed = std::max(1, std::abs(p.ball.vx));  // Ensure minimum speed
     
     if (bc < cc) {
-      cpu.y -= speed;
+      p.cpu.y -= speed;
     } else if (bc > cc) {
-      cpu.y += speed;
+      p.cpu.y += speed;
     }
     
     // Constrain CPU paddle
-    if (cpu.y < STATUS_BAR_HEIGHT) {
-      cpu.y = STATUS_BAR_HEIGHT;
+    if (p.cpu.y < STATUS_BAR_HEIGHT) {
+      p.cpu.y = STATUS_BAR_HEIGHT;
     }
-    if (cpu.y > SCREEN_HEIGHT - PADDLE_HEIGHT) {
-      cpu.y = SCREEN_HEIGHT - PADDLE_HEIGHT;
+    if (p.cpu.y > SCREEN_HEIGHT - PADDLE_HEIGHT) {
+      p.cpu.y = SCREEN_HEIGHT - PADDLE_HEIGHT;
     }
   }
 
-  static bool updateBall() {
-    if (!gameActive) return true;
-    ball.x += ball.vx; 
-    ball.y += ball.vy;
+  static bool updateBall(PongState& p) {
+    if (!p.gameActive) return true;
+    p.ball.x += p.ball.vx; 
+    p.ball.y += p.ball.vy;
 
     // Bounce off top/bottom
-    if (ball.y <= STATUS_BAR_HEIGHT || ball.y >= SCREEN_HEIGHT - BALL_SIZE) {
-      ball.vy = -ball.vy;
+    if (p.ball.y <= STATUS_BAR_HEIGHT || p.ball.y >= SCREEN_HEIGHT - BALL_SIZE) {
+      p.ball.vy = -p.ball.vy;
     }
 
     // CPU collision
-    if (ball.x <= cpu.x + PADDLE_WIDTH &&
-        ball.y + BALL_SIZE >= cpu.y && ball.y <= cpu.y + PADDLE_HEIGHT) {
-      ball.x = cpu.x + PADDLE_WIDTH;
-      ball.vx = -ball.vx;
+    if (p.ball.x <= p.cpu.x + PADDLE_WIDTH &&
+        p.ball.y + BALL_SIZE >= p.cpu.y && p.ball.y <= p.cpu.y + PADDLE_HEIGHT) {
+      p.ball.x = p.cpu.x + PADDLE_WIDTH;
+      p.ball.vx = -p.ball.vx;
     }
     
     // Player collision
-    if (ball.x + BALL_SIZE >= player.x &&
-        ball.y + BALL_SIZE >= player.y && ball.y <= player.y + PADDLE_HEIGHT) {
-      ball.x = player.x - BALL_SIZE;
-      ball.vx = -ball.vx;
-      playerScore++;
-      drawStatusBar("PONG", playerScore, getHighScore(GameID::PONG));
+    if (p.ball.x + BALL_SIZE >= p.player.x &&
+        p.ball.y + BALL_SIZE >= p.player.y && p.ball.y <= p.player.y + PADDLE_HEIGHT) {
+      p.ball.x = p.player.x - BALL_SIZE;
+      p.ball.vx = -p.ball.vx;
+      p.playerScore++;
     }
     
     // Ball out of bounds
-    if (ball.x > SCREEN_WIDTH || ball.x < 0) {
+    if (p.ball.x > SCREEN_WIDTH || p.ball.x < 0) {
       return false;
     }
     return true;
   }
 
-  static void drawDashedCourt() {
+  static void drawDashedCourt(Device& dev) {
     const int dash=2, gap=2;
-    // Top and bottom borders
+    // Top and bottom borders (one FillRect per dash; clipped at the edge)
     for (int x=0; x<SCREEN_WIDTH; x+=dash+gap) {
-      for (int i=0; i<dash && x+i<SCREEN_WIDTH; ++i) {
-        DrawPixel(x+i, STATUS_BAR_HEIGHT, true); 
-        DrawPixel(x+i, SCREEN_HEIGHT-1, true); 
-      }
+      dev.FillRect(x, STATUS_BAR_HEIGHT, dash, 1, true);
+      dev.FillRect(x, SCREEN_HEIGHT-1,   dash, 1, true);
     }
     // Side borders
     for (int y=STATUS_BAR_HEIGHT; y<SCREEN_HEIGHT; y+=dash+gap) {
-      for (int i=0; i<dash && y+i<SCREEN_HEIGHT; ++i) {
-        DrawPixel(0, y+i, true); 
-        DrawPixel(SCREEN_WIDTH-1, y+i, true); 
-      }
+      dev.FillRect(0,              y, 1, dash, true);
+      dev.FillRect(SCREEN_WIDTH-1, y, 1, dash, true);
     }
     // Center line
     for (int y = STATUS_BAR_HEIGHT; y < SCREEN_HEIGHT; y += 4) {
-      DrawPixel(SCREEN_WIDTH/2, y, true);
+      dev.DrawPixel(SCREEN_WIDTH/2, y, true);
     }
   }
 
-  static void drawGame() {
-    clearPlayfield();
-    drawStatusBar("PONG", playerScore, getHighScore(GameID::PONG));
-    drawDashedCourt();
-    FillRect(cpu.x,    cpu.y,    PADDLE_WIDTH, PADDLE_HEIGHT, true);
-    FillRect(player.x, player.y, PADDLE_WIDTH, PADDLE_HEIGHT, true);
-    FillRect(ball.x,   ball.y,   BALL_SIZE,    BALL_SIZE,     true);
-    Present();
+  // Position between the previous and current tick, snapped to a pixel
+  static int lerpPx(int from, int to, float t) {
+    return from + static_cast<int>(std::floor((to - from) * t + 0.5f));
+  }
+
+  static void drawMovers(Device& dev, const PongState& p, const PongState::Drawn& d) {
+    dev.DrawSprite(p.cpu.x,    d.cpuY,    Assets::PADDLE, Raster::Rop::XOR);
+    dev.DrawSprite(p.player.x, d.playerY, Assets::PADDLE, Raster::Rop::XOR);
+    dev.DrawSprite(d.ballX,    d.ballY,   Assets::BALL,   Raster::Rop::XOR);
+  }
+
+  // alpha: fraction of a tick elapsed since the last one, in [0, 1)
+  static void drawGame(GameContext& ctx, float alpha) {
+    BLOOP_TRACE_SCOPE("drawGame");
+    PongState& p = ctx.games.As<PongState>();
+    Device& dev = ctx.dev;
+    PongState::Drawn next;
+    next.cpuY    = lerpPx(p.prevCpuY,   p.cpu.y,  alpha);
+    next.playerY = p.player.y;
+    next.ballX   = lerpPx(p.prevBall.x, p.ball.x, alpha);
+    next.ballY   = lerpPx(p.prevBall.y, p.ball.y, alpha);
+    drawStatusBar(ctx, gameName(GameID::PONG), p.playerScore, getHighScore(ctx, GameID::PONG));
+    // Nothing moved a pixel: erasing and redrawing would still count as a change
+    bool moved = !p.drawnValid || next.cpuY != p.drawn.cpuY || next.playerY != p.drawn.playerY ||
+                 next.ballX != p.drawn.ballX || next.ballY != p.drawn.ballY;
+    if (moved) {
+      if (p.drawnValid) {
+        drawMovers(dev, p, p.drawn);  // erase: the court under them comes back
+      } else {
+        clearPlayfield(ctx);
+        drawDashedCourt(dev);
+      }
+      p.drawn = next;
+      p.drawnValid = true;
+      drawMovers(dev, p, p.drawn);
+    }
+    dev.Present();
   }
 
 } // anon
 
-void startPong() {
-  inited = true;
-  resetGame();
-  showGetReady("PONG", "A: Up, B: Down");
-  readyUntil = Millis() + 1000; // 1s
-  clearedAfterReady = false;
-  exitHoldStart = 0;
+void resetPongCourt(PongState& p) {
+  p.player.x = SCREEN_WIDTH - PADDLE_WIDTH - PADDLE_OFFSET;
+  p.player.y = STATUS_BAR_HEIGHT + PLAYFIELD_HEIGHT/2 - PADDLE_HEIGHT/2;
+  p.cpu.x    = PADDLE_OFFSET;
+  p.cpu.y    = STATUS_BAR_HEIGHT + PLAYFIELD_HEIGHT/2 - PADDLE_HEIGHT/2;
+  p.ball.x   = SCREEN_WIDTH/2;
+  p.ball.y   = STATUS_BAR_HEIGHT + PLAYFIELD_HEIGHT/2;
+  p.ball.vx  = 0; 
+  p.ball.vy = 0;
+  p.playerScore = 0;
+  p.gameActive  = false;
+  p.prevBall = p.ball;
+  p.prevCpuY = p.cpu.y;
+}
+
+bool pongPhysicsTick(PongState& p) {
+  updateCPU(p);
+  return updateBall(p);
 }
 
-bool stepPong(int& outScore, bool& exitRequested, bool& gameOver) {
-  if (!inited) startPong();
+// Get Ready for 1s, then the bare playfield
+static Flow pongIntro(GameContext& ctx) {
+  showGetReady(ctx, gameName(GameID::PONG), "A: Up, B: Down");
+  co_await sleepFor(1000);
+  clearPlayfield(ctx);
+  ctx.dev.Present();
+}
+
+void startPong(GameContext& ctx) {
+  PongState& p = ctx.games.Holds<PongState>() ? ctx.games.As<PongState>() : ctx.games.Emplace<PongState>();
+  p.inited = true;
+  resetGame(ctx);
+  p.drawnValid = false;
+  ctx.exitHold = Flow();
+  ctx.intro = pongIntro(ctx);
+  ctx.intro.Resume(ctx.frame.now);
+}
+
+bool stepPong(GameContext& ctx, int& outScore, bool& exitRequested, bool& gameOver) {
+  BLOOP_TRACE_SCOPE("stepPong");
+  PongState& p = ctx.games.As<PongState>();
+  Device& dev = ctx.dev;
+  const uint64_t now = ctx.frame.now;
+  if (!p.inited) startPong(ctx);
 
   // Pause during Get Ready
-  if (Millis() < readyUntil) return true;
-  if (!clearedAfterReady) { 
-    clearPlayfield(); 
-    Present(); 
-    clearedAfterReady = true; 
-  }
+  if (ctx.intro.Resume(now)) return true;
 
-  InputState in = getInputState();
+  InputState in = getInputState(ctx);
 
   // Hold-to-exit (PAUSES GAME)
-  if (in.both) {
-    if (exitHoldStart == 0) exitHoldStart = Millis();
-    float prog = (float)(Millis() - exitHoldStart) / 1500.0f;
-    if (prog >= 1.0f) { 
-      exitRequested = true; 
-      exitHoldStart = 0;
-      // Reset input states to prevent menu interference
-      prevAPressed = prevBPressed = false;
-      return true; 
-    }
-    showExitHoldBar(prog);
-    Delay(50);
+  if (in.both && !ctx.exitHold.Running()) ctx.exitHold = holdToExit(ctx);
+  if (ctx.exitHold.Resume(now)) {
+    p.drawnValid = false;  // the bar drew over the bottom rows
+    return true;
+  }
+  if (exitRequested) {
+    // Reset input states to prevent menu interference
+    p.prevAPressed = p.prevBPressed = false;
     return true;
-  } else {
-    exitHoldStart = 0;
   }
 
   // Enhanced paddle movement with debouncing
-  unsigned long now = Millis();
-  bool canProcessInput = (now - lastInputTime) > INPUT_COOLDOWN_MS;
+  bool canProcessInput = (now - p.lastInputTime) > INPUT_COOLDOWN_MS;
   
   if (canProcessInput) {
     bool currentAPressed = in.buttonA;
     bool currentBPressed = in.buttonB;
     
     // Calculate paddle speed with scaling
-    int paddleSpeed = std::max(1, (int)(PADDLE_SPEED_BASE / SpeedScale()));
+    int paddleSpeed = std::max(1, (int)(p.paddleSpeed / dev.SpeedScale()));
     bool moved = false;
     
     // Continuous movement while button is held
-    if (currentAPressed && player.y > STATUS_BAR_HEIGHT + 2) { 
-      player.y -= paddleSpeed; 
+    if (currentAPressed && p.player.y > STATUS_BAR_HEIGHT + 2) { 
+      p.player.y -= paddleSpeed; 
       moved = true; 
-      lastInputTime = now;
+      p.lastInputTime = now;
     }
-    if (currentBPressed && player.y < SCREEN_HEIGHT - PADDLE_HEIGHT - 2) { 
-      player.y += paddleSpeed; 
+    if (currentBPressed && p.player.y < SCREEN_HEIGHT - PADDLE_HEIGHT - 2) { 
+      p.player.y += paddleSpeed; 
       moved = true; 
-      lastInputTime = now;
+      p.lastInputTime = now;
     }
     
     // Serve ball on first movement
-    if (!gameActive && moved) {
-      serveBall();
+    if (!p.gameActive && moved) {
+      serveBall(ctx);
     }
     
     // Update previous state
-    prevAPressed = currentAPressed;
-    prevBPressed = currentBPressed;
+    p.prevAPressed = currentAPressed;
+    p.prevBPressed = currentBPressed;
   }
 
-  // Tick update with scaling
-  const unsigned tickMs = (unsigned)(TICK_MS_BASE * SpeedScale());
-  if (Millis() - lastTick >= tickMs) {
-    updateCPU();
-    if (!updateBall()) { 
+  // Fixed-step physics at 1000/tickMs Hz, decoupled from the frame rate;
+  // drawing interpolates between the last two ticks
+  const unsigned tickMs = (unsigned)(p.tickMs * dev.SpeedScale());
+  if (now - p.lastTick > MAX_CATCHUP_TICKS * tickMs) p.lastTick = now - tickMs;
+  while (now - p.lastTick >= tickMs) {
+    p.prevBall = p.ball;
+    p.prevCpuY = p.cpu.y;
+    if (!pongPhysicsTick(p)) { 
       gameOver = true; 
-      outScore = playerScore;
+      outScore = p.playerScore;
       // Reset input states
-      prevAPressed = prevBPressed = false;
+      p.prevAPressed = p.prevBPressed = false;
       return true; 
     }
-    lastTick = Millis();
+    p.lastTick += tickMs;
   }
 
-  drawGame();
-  outScore = playerScore;
+  drawGame(ctx, (float)(now - p.lastTick) / tickMs);
+  outScore = p.playerScore;
   gameOver = false;
   return true;
-}
\ No newline at end of file
+}
+
+// Paddles, ball, score and difficulty: 12 B
+bool snapshotPong(const PongState& p, SnapWriter& w) {
+  w.U8(p.player.y); w.U8(p.cpu.y);
+  w.U8(p.ball.x);   w.U8(p.ball.y);
+  w.I8(p.ball.vx);  w.I8(p.ball.vy);
+  w.U16(p.playerScore);
+  w.U8(p.gameActive);
+  w.U8(p.paddleSpeed);
+  w.U16(p.tickMs);
+  return w.Ok();
+}
+
+bool restorePong(GameContext& ctx, SnapReader& r) {
+  PongState& p = ctx.games.Emplace<PongState>();
+  resetPongCourt(p);
+  p.player.y = r.U8(); p.cpu.y = r.U8();
+  p.ball.x   = r.U8(); p.ball.y = r.U8();
+  p.ball.vx  = r.I8(); p.ball.vy = r.I8();
+  p.playerScore = r.U16();
+  p.gameActive  = r.U8() != 0;
+  p.paddleSpeed = r.U8();
+  p.tickMs      = r.U16();
+  bool ok = r.Ok() && r.Done() &&
+            p.player.y <= SCREEN_HEIGHT - PADDLE_HEIGHT && p.cpu.y <= SCREEN_HEIGHT - PADDLE_HEIGHT &&
+            p.ball.x <= SCREEN_WIDTH && p.ball.y < SCREEN_HEIGHT && p.paddleSpeed > 0 && p.tickMs > 0;
+  if (!ok) {
+    ctx.games.Destroy();
+    return false;
+  }
+  p.prevBall = p.ball;
+  p.prevCpuY = p.cpu.y;
+  p.drawnValid = false;
+  p.lastTick = ctx.frame.now;
+  p.lastInputTime = 0;
+  p.prevAPressed = p.prevBPressed = false;
+  p.inited = true;
+  ctx.exitHold = Flow();
+  ctx.intro = Flow();
+  return true;
+}
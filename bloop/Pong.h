@@ -1,6 +1,66 @@
 #pragma once
-#include "GameManager.h"
+#include "platform.h"
+
+struct GameContext;
+class SnapWriter;
+class SnapReader;
+
+// Per-session pong state
+struct PongState {
+  static constexpr const char* NAME = "pong";
+  static constexpr std::size_t RAM_BUDGET = 256;                   // game_arena.h
+
+  // Court geometry (also used by the batched host simulator)
+  static constexpr int PADDLE_HEIGHT = 10;
+  static constexpr int PADDLE_WIDTH  = 2;
+  static constexpr int BALL_SIZE     = 2;
+  static constexpr int PADDLE_OFFSET = 3;
+  static constexpr int PADDLE_SPEED_BASE  = 3;     // Increased from 2 for better responsiveness
+  static constexpr unsigned TICK_MS_BASE  = 32;    // ~31 Hz fixed step; the old 25 ms tick fired every other 16 ms frame
+
+  struct Paddle { int x,y; };
+  struct Ball { int x,y, vx, vy; };
+
+  Paddle player = {0, 0}, cpu = {0, 0};
+  Ball   ball = {0, 0, 0, 0};
+
+  // Ball and CPU paddle as of the previous tick; the renderer interpolates
+  // from these toward the current tick
+  Ball   prevBall = {0, 0, 0, 0};
+  int    prevCpuY = 0;
+
+  // Paddles and ball as last drawn, with XOR: drawing them again erases them,
+  // so a frame only touches what moved. drawnValid is cleared whenever
+  // something else draws over the playfield.
+  struct Drawn { int cpuY, playerY, ballX, ballY; };
+  Drawn  drawn = {0, 0, 0, 0};
+  bool   drawnValid = false;
+  int    playerScore = 0;
+  bool   gameActive  = false;
+
+  uint64_t lastTick = 0;
+  bool     inited = false;
+
+  // Enhanced input handling
+  bool prevAPressed = false;
+  bool prevBPressed = false;
+  uint64_t lastInputTime = 0;
+
+  // Difficulty; host tools override it after Emplace() for tuning runs
+  int      paddleSpeed = PADDLE_SPEED_BASE;
+  unsigned tickMs      = TICK_MS_BASE;
+};
+
+// Pure simulation pieces: court reset and one physics tick (CPU paddle, then
+// ball). pongPhysicsTick returns false once the ball leaves the court.
+void resetPongCourt(PongState& p);
+bool pongPhysicsTick(PongState& p);
 
 // Non-blocking per-frame pong
-void startPong();
-bool stepPong(int& outScore, bool& exitRequested, bool& gameOver);
+void startPong(GameContext& ctx);
+bool stepPong(GameContext& ctx, int& outScore, bool& exitRequested, bool& gameOver);
+
+// Suspend snapshot payload (snapshot.h); restorePong() builds the state in
+// the arena and leaves it empty if the bytes are out of range
+bool snapshotPong(const PongState& p, SnapWriter& w);
+bool restorePong(GameContext& ctx, SnapReader& r);
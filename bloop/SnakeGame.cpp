@@ -1,220 +1,317 @@
 #include "SnakeGame.h"
+#include "GameManager.h"
 #include "platform.h"
+#include "assets.h"
+#include "snapshot.h"
 #include <algorithm>
 #include <cstdlib>
 
 using namespace Platform;
 
 namespace {
-  constexpr int GRID_SIZE   = 4;
-  constexpr int GRID_HEIGHT = PLAYFIELD_HEIGHT / GRID_SIZE;
-  constexpr int GRID_WIDTH  = SCREEN_WIDTH / GRID_SIZE;
-  constexpr int MAX_SNAKE_LENGTH = 64;
-  constexpr unsigned MOVE_DELAY_MS_BASE = 200;   // Reduced from 300ms for better responsiveness
+  constexpr int VIEW_COLS = SnakeState::COLS;
+  constexpr int VIEW_ROWS = SnakeState::ROWS;
   constexpr int INITIAL_SNAKE_LENGTH = 3;
+  constexpr unsigned INPUT_COOLDOWN_MS = 100;  // Prevent double presses
 
-  enum Dir { RIGHT, DOWN, LEFT, UP };
-  struct Pt { int x, y; };
-
-  static Pt  snake[MAX_SNAKE_LENGTH];
-  static int snakeLen;
-  static Dir dir;
-  static Pt  food;
-  static unsigned long lastMoveTime;
-  static unsigned long exitHoldStart = 0;
-  static bool inited = false;
-
-  // Enhanced input handling
-  static bool prevAPressed = false;
-  static bool prevBPressed = false;
-  static unsigned long lastInputTime = 0;
-  static constexpr unsigned INPUT_COOLDOWN_MS = 100;  // Prevent double presses
-
-  // Get Ready gating
-  static unsigned long readyUntil = 0;
-  static bool clearedAfterReady = false;
+  using Dir = SnakeState::Dir;
+  using Pt  = SnakeState::Pt;
+  constexpr Dir RIGHT = SnakeState::RIGHT, DOWN = SnakeState::DOWN,
+                LEFT  = SnakeState::LEFT,  UP   = SnakeState::UP;
+  constexpr uint8_t EMPTY = SnakeState::EMPTY, BODY = SnakeState::BODY, FOOD = SnakeState::FOOD;
 
   static bool isValid(Dir nd, Dir cd) {
     return !((nd==UP && cd==DOWN) || (nd==DOWN && cd==UP) ||
              (nd==LEFT && cd==RIGHT) || (nd==RIGHT && cd==LEFT));
   }
 
-  static void placeFood() {
-    bool ok;
+  template <class S>
+  static void placeFood(GameContext& ctx, S& s) {
     int attempts = 0;
     do {
-      ok = true;
-      food.x = RandomInt(0, GRID_WIDTH);
-      food.y = RandomInt(0, GRID_HEIGHT);
-      for (int i=0;i<snakeLen;i++) {
-        if (snake[i].x==food.x && snake[i].y==food.y) { 
-          ok=false; 
-          break; 
-        }
-      }
+      s.food.x = ctx.dev.RandomInt(0, s.worldCols);
+      s.food.y = ctx.dev.RandomInt(0, s.worldRows);
       attempts++;
-    } while(!ok && attempts < 100);  // Prevent infinite loop
+    } while (s.world.Get(s.food.x, s.food.y) != EMPTY && attempts < 100);  // Prevent infinite loop
+    if (s.world.Get(s.food.x, s.food.y) == EMPTY) s.world.Set(s.food.x, s.food.y, FOOD);
   }
 
-  static void resetSnake() {
-    snakeLen = INITIAL_SNAKE_LENGTH;
-    snake[0] = {GRID_WIDTH/2, GRID_HEIGHT/2};
-    snake[1] = {GRID_WIDTH/2 - 1, GRID_HEIGHT/2};
-    snake[2] = {GRID_WIDTH/2 - 2, GRID_HEIGHT/2};
-    dir = RIGHT;
-    placeFood();
-    lastMoveTime = Millis();
-    lastInputTime = 0;
-    prevAPressed = prevBPressed = false;
+  // Big map: keep the head in the middle of the viewport
+  template <class S>
+  static void follow(S& s) {
+    if (!s.BigMap()) return;
+    Pt h = s.Head();
+    s.camera.x = (h.x - VIEW_COLS / 2 + s.worldCols) % s.worldCols;
+    s.camera.y = (h.y - VIEW_ROWS / 2 + s.worldRows) % s.worldRows;
   }
 
-  static bool moveSnake() {
-    // Remember old tail before shifting so growth can append it
-    Pt oldTail = snake[snakeLen - 1];
+  // Camera, tile map and timers for a game starting (or resuming) now
+  template <class S>
+  static void resetView(GameContext& ctx, S& s) {
+    s.camera = {0, 0};
+    follow(s);
+    s.tiles.Init(Assets::SNAKE_TILES, 0, STATUS_BAR_HEIGHT);
+    s.viewDirty = true;
+    s.lastMoveTime = ctx.frame.now;
+    s.lastInputTime = 0;
+    s.prevAPressed = s.prevBPressed = false;
+  }
 
-    // Shift body forward
-    for (int i = snakeLen - 1; i > 0; --i) {
-      snake[i] = snake[i - 1];
+  template <class S>
+  static void resetSnake(GameContext& ctx, S& s) {
+    s.worldCols = std::min(std::max(s.worldCols, VIEW_COLS), static_cast<int>(S::MAX_WORLD_COLS));
+    s.worldRows = std::min(std::max(s.worldRows, VIEW_ROWS), static_cast<int>(S::MAX_WORLD_ROWS));
+    s.world.Fill(EMPTY);
+    s.length = INITIAL_SNAKE_LENGTH;
+    s.head = 0;
+    for (int i = 0; i < s.length; ++i) {
+      s.ring[i] = { static_cast<uint8_t>(s.worldCols / 2 - i), static_cast<uint8_t>(s.worldRows / 2) };
+      s.world.Set(s.ring[i].x, s.ring[i].y, BODY);
     }
+    s.dir = RIGHT;
+    // One food per screenful of world
+    int foods = (s.worldCols * s.worldRows) / (VIEW_COLS * VIEW_ROWS);
+    for (int i = 0; i < foods; ++i) placeFood(ctx, s);
+    resetView(ctx, s);
+  }
+
+  template <class S>
+  static bool moveSnake(GameContext& ctx, S& s) {
+    Pt h = s.Head();
 
     // Advance head
-    switch (dir) { 
-      case UP:    snake[0].y--; break;
-      case DOWN:  snake[0].y++; break;
-      case LEFT:  snake[0].x--; break;
-      case RIGHT: snake[0].x++; break; 
+    switch (s.dir) { 
+      case UP:    h.y--; break;
+      case DOWN:  h.y++; break;
+      case LEFT:  h.x--; break;
+      case RIGHT: h.x++; break; 
     }
 
-    // Wrap around screen
-    if (snake[0].x < 0) snake[0].x = GRID_WIDTH - 1;
-    if (snake[0].x >= GRID_WIDTH) snake[0].x = 0;
-    if (snake[0].y < 0) snake[0].y = GRID_HEIGHT - 1;
-    if (snake[0].y >= GRID_HEIGHT) snake[0].y = 0;
+    // Wrap around the world
+    if (h.x < 0) h.x = s.worldCols - 1;
+    if (h.x >= s.worldCols) h.x = 0;
+    if (h.y < 0) h.y = s.worldRows - 1;
+    if (h.y >= s.worldRows) h.y = 0;
+
+    // Vacate the tail first: the head may move into the cell it leaves
+    SnakeState::Seg tail = s.ring[(s.head + s.length - 1) % S::RING];
+    s.world.Set(tail.x, tail.y, EMPTY);
 
     // Self-collision check
-    for (int i = 1; i < snakeLen; ++i) {
-      if (snake[0].x == snake[i].x && snake[0].y == snake[i].y) {
-        return false;
-      }
-    }
+    uint8_t hit = s.world.Get(h.x, h.y);
+    if (hit == BODY) return false;
 
-    // Food collision
-    if (snake[0].x == food.x && snake[0].y == food.y) {
-      if (snakeLen < MAX_SNAKE_LENGTH) {
-        snakeLen = std::min(snakeLen + 1, MAX_SNAKE_LENGTH);
-        snake[snakeLen - 1] = oldTail;
+    s.head = (s.head + S::RING - 1) % S::RING;
+    s.ring[s.head] = { static_cast<uint8_t>(h.x), static_cast<uint8_t>(h.y) };
+    s.world.Set(h.x, h.y, BODY);
+
+    // Food collision: growing keeps the old tail
+    if (hit == FOOD) {
+      if (s.length < S::RING) {
+        s.length++;
+        s.world.Set(tail.x, tail.y, BODY);
       }
-      placeFood();
+      placeFood(ctx, s);
     }
 
+    follow(s);
+    s.viewDirty = true;
     return true;
   }
 
-  static void drawSnake(int score) {
-    // Full redraw each frame to prevent ghost artifacts
-    clearPlayfield();
-    drawStatusBar("SNAKE", score, getHighScore(GameID::SNAKE));
-
-    // Draw snake body
-    for (int i=0;i<snakeLen;i++) {
-      FillRect(snake[i].x*GRID_SIZE, snake[i].y*GRID_SIZE + STATUS_BAR_HEIGHT, GRID_SIZE, GRID_SIZE, true);
+  // Copies the world under the camera into the tile map, which marks only
+  // the cells that differ: VIEW_COLS x VIEW_ROWS lookups at any world size
+  template <class S>
+  static void syncView(S& s) {
+    int wx[VIEW_COLS];
+    for (int c = 0; c < VIEW_COLS; ++c) wx[c] = (s.camera.x + c) % s.worldCols;
+    for (int r = 0; r < VIEW_ROWS; ++r) {
+      int wy = (s.camera.y + r) % s.worldRows;
+      for (int c = 0; c < VIEW_COLS; ++c) s.tiles.Set(c, r, s.world.Get(wx[c], wy));
     }
+    s.viewDirty = false;
+  }
 
-    // Draw food
-    FillRect(food.x*GRID_SIZE, food.y*GRID_SIZE + STATUS_BAR_HEIGHT, GRID_SIZE, GRID_SIZE, true);
-    Present();
+  // The tile map repaints only the viewport cells that changed
+  template <class S>
+  static void drawSnake(GameContext& ctx, S& s, int score) {
+    BLOOP_TRACE_SCOPE("drawSnake");
+    Device& dev = ctx.dev;
+    drawStatusBar(ctx, gameName(ctx.activeGame), score, getHighScore(ctx, ctx.activeGame));
+    if (s.viewDirty) syncView(s);
+    dev.DrawLayer(s.tiles);
+    dev.Present();
   }
 
-} // anon
+  // Get Ready for 1s, then the bare playfield. The state outlives the
+  // intro, which only runs inside its game's step.
+  static Flow snakeIntro(GameContext& ctx, SnakeRules& s) {
+    showGetReady(ctx, gameName(ctx.activeGame), "A: Left, B: Right");
+    co_await sleepFor(1000);
+    clearPlayfield(ctx);
+    ctx.dev.Present();
+    s.tiles.Invalidate();
+  }
 
-void startSnake() {
-  inited = true;
-  resetSnake();
-  showGetReady("SNAKE", "A: Left, B: Right");
-  exitHoldStart = 0;
-  readyUntil = Millis() + 1000;  // 1s get-ready
-  clearedAfterReady = false;
-}
+  template <class S>
+  static void start(GameContext& ctx, S& s) {
+    s.inited = true;
+    resetSnake(ctx, s);
+    ctx.exitHold = Flow();
+    ctx.intro = snakeIntro(ctx, s);
+    ctx.intro.Resume(ctx.frame.now);
+  }
 
-bool stepSnake(int& outScore, bool& exitRequested, bool& gameOver) {
-  if (!inited) startSnake();
+  template <class S>
+  static bool step(GameContext& ctx, S& s, int& outScore, bool& exitRequested, bool& gameOver) {
+    Device& dev = ctx.dev;
+    const uint64_t now = ctx.frame.now;
+    if (!s.inited) start(ctx, s);
 
-  // Pause during Get Ready
-  if (Millis() < readyUntil) return true;
-  if (!clearedAfterReady) { 
-    clearPlayfield(); 
-    Present(); 
-    clearedAfterReady = true; 
-  }
+    // Pause during Get Ready
+    if (ctx.intro.Resume(now)) return true;
 
-  InputState in = getInputState();
+    InputState in = getInputState(ctx);
 
-  // Hold-to-exit (PAUSES GAME)
-  if (in.both) {
-    if (exitHoldStart == 0) exitHoldStart = Millis();
-    float prog = (float)(Millis() - exitHoldStart) / 1500.0f;
-    if (prog >= 1.0f) { 
-      exitRequested = true; 
-      exitHoldStart = 0;
+    // Hold-to-exit (PAUSES GAME)
+    if (in.both && !ctx.exitHold.Running()) ctx.exitHold = holdToExit(ctx);
+    if (ctx.exitHold.Resume(now)) {
+      s.tiles.Invalidate();  // the bar covers the bottom cell row
+      return true;
+    }
+    if (exitRequested) {
       // Reset input states to prevent menu interference
-      prevAPressed = prevBPressed = false;
-      return true; 
+      s.prevAPressed = s.prevBPressed = false;
+      return true;
     }
-    showExitHoldBar(prog);
-    Delay(50);
-    return true;
-  } else {
-    exitHoldStart = 0;
-  }
 
-  // Enhanced turn handling with debouncing
-  unsigned long now = Millis();
-  bool canProcessInput = (now - lastInputTime) > INPUT_COOLDOWN_MS;
+    // Enhanced turn handling with debouncing
+    bool canProcessInput = (now - s.lastInputTime) > INPUT_COOLDOWN_MS;
   
-  if (canProcessInput) {
-    bool currentAPressed = in.buttonA;
-    bool currentBPressed = in.buttonB;
+    if (canProcessInput) {
+      bool currentAPressed = in.buttonA;
+      bool currentBPressed = in.buttonB;
     
-    // Detect rising edge (button press, not hold)
-    bool aPressedNow = currentAPressed && !prevAPressed;
-    bool bPressedNow = currentBPressed && !prevBPressed;
+      // Detect rising edge (button press, not hold)
+      bool aPressedNow = currentAPressed && !s.prevAPressed;
+      bool bPressedNow = currentBPressed && !s.prevBPressed;
     
-    if (aPressedNow) {
-      Dir newDir = (Dir)((dir + 3) % 4); // Counter-clockwise
-      if (isValid(newDir, dir)) {
-        dir = newDir;
-        lastInputTime = now;
+      if (aPressedNow) {
+        Dir newDir = (Dir)((s.dir + 3) % 4); // Counter-clockwise
+        if (isValid(newDir, s.dir)) {
+          s.dir = newDir;
+          s.lastInputTime = now;
+        }
+      } else if (bPressedNow) {
+        Dir newDir = (Dir)((s.dir + 1) % 4); // Clockwise
+        if (isValid(newDir, s.dir)) {
+          s.dir = newDir;
+          s.lastInputTime = now;
+        }
       }
-    } else if (bPressedNow) {
-      Dir newDir = (Dir)((dir + 1) % 4); // Clockwise
-      if (isValid(newDir, dir)) {
-        dir = newDir;
-        lastInputTime = now;
+    
+      // Update previous state
+      s.prevAPressed = currentAPressed;
+      s.prevBPressed = currentBPressed;
+    }
+
+    int score = s.length - INITIAL_SNAKE_LENGTH;
+
+    // Movement timing with scaling
+    const unsigned moveDelay = (unsigned)(s.moveDelayMs * dev.SpeedScale());
+    if (now - s.lastMoveTime > moveDelay) {
+      if (!moveSnake(ctx, s)) { 
+        gameOver = true; 
+        outScore = score; 
+        // Reset input states
+        s.prevAPressed = s.prevBPressed = false;
+        return true; 
       }
+      s.lastMoveTime = now;
     }
-    
-    // Update previous state
-    prevAPressed = currentAPressed;
-    prevBPressed = currentBPressed;
+
+    drawSnake(ctx, s, score);
+    outScore = score;
+    gameOver = false;
+    return true;
   }
 
-  int score = snakeLen - INITIAL_SNAKE_LENGTH;
-
-  // Movement timing with scaling
-  const unsigned moveDelay = (unsigned)(MOVE_DELAY_MS_BASE * SpeedScale());
-  if (Millis() - lastMoveTime > moveDelay) {
-    if (!moveSnake()) { 
-      gameOver = true; 
-      outScore = score; 
-      // Reset input states
-      prevAPressed = prevBPressed = false;
-      return true; 
-    }
-    lastMoveTime = Millis();
+} // anon
+
+void startSnake(GameContext& ctx) {
+  if (BigSnakeState* b = ctx.games.Get<BigSnakeState>()) start(ctx, *b);
+  else start(ctx, ctx.games.Holds<SnakeState>() ? ctx.games.As<SnakeState>() : ctx.games.Emplace<SnakeState>());
+}
+
+bool stepSnake(GameContext& ctx, int& outScore, bool& exitRequested, bool& gameOver) {
+  BLOOP_TRACE_SCOPE("stepSnake");
+  if (BigSnakeState* b = ctx.games.Get<BigSnakeState>()) return step(ctx, *b, outScore, exitRequested, gameOver);
+  if (!ctx.games.Holds<SnakeState>()) startSnake(ctx);
+  return step(ctx, ctx.games.As<SnakeState>(), outScore, exitRequested, gameOver);
+}
+
+// Classic board only: head, food, then each body segment as the 2-bit
+// direction from the one before it, four to a byte (at most 24 B). Big
+// Snake's foods alone would not fit, so it is never saved.
+bool snapshotSnake(const SnakeState& s, SnapWriter& w) {
+  if (s.length < 1) return false;
+  w.U8(s.dir);
+  w.U8(s.length);
+  Pt h = s.Head();
+  w.U8(h.x); w.U8(h.y);
+  w.U8(s.food.x); w.U8(s.food.y);
+  w.U16(s.moveDelayMs);
+  uint32_t bits = 0;
+  int used = 0;
+  for (int i = 1; i < s.length; ++i) {
+    Pt a = s.Segment(i - 1), b = s.Segment(i);
+    int d = b.x == (a.x + 1) % s.worldCols ? RIGHT
+          : b.y == (a.y + 1) % s.worldRows ? DOWN
+          : b.x == (a.x + s.worldCols - 1) % s.worldCols ? LEFT : UP;
+    bits |= static_cast<uint32_t>(d) << used;
+    if ((used += 2) == 8) { w.U8(bits); bits = 0; used = 0; }
   }
+  if (used) w.U8(bits);
+  return w.Ok();
+}
 
-  drawSnake(score);
-  outScore = score;
-  gameOver = false;
+bool restoreSnake(GameContext& ctx, SnapReader& r) {
+  SnakeState& s = ctx.games.Emplace<SnakeState>();
+  int dir = r.U8(), length = r.U8();
+  int hx = r.U8(), hy = r.U8();
+  s.food = { static_cast<int>(r.U8()), static_cast<int>(r.U8()) };
+  s.moveDelayMs = r.U16();
+  bool ok = r.Ok() && dir < 4 && length >= 1 && length <= SnakeState::MAX_LENGTH &&
+            hx < VIEW_COLS && hy < VIEW_ROWS && s.food.x < VIEW_COLS && s.food.y < VIEW_ROWS;
+  s.world.Fill(EMPTY);
+  s.head = 0;
+  s.length = ok ? length : 0;
+  uint32_t bits = 0;
+  for (int i = 0; ok && i < length; ++i) {
+    if (i > 0) {
+      if ((i - 1) % 4 == 0) bits = r.U8();
+      Pt p = { s.ring[i - 1].x, s.ring[i - 1].y };
+      switch ((bits >> ((i - 1) % 4 * 2)) & 3) {
+        case RIGHT: p.x = (p.x + 1) % VIEW_COLS; break;
+        case DOWN:  p.y = (p.y + 1) % VIEW_ROWS; break;
+        case LEFT:  p.x = (p.x + VIEW_COLS - 1) % VIEW_COLS; break;
+        case UP:    p.y = (p.y + VIEW_ROWS - 1) % VIEW_ROWS; break;
+      }
+      hx = p.x; hy = p.y;
+    }
+    ok = r.Ok() && s.world.Get(hx, hy) == EMPTY;   // a body never crosses itself
+    s.ring[i] = { static_cast<uint8_t>(hx), static_cast<uint8_t>(hy) };
+    s.world.Set(hx, hy, BODY);
+  }
+  if (!ok || !r.Done() || s.world.Get(s.food.x, s.food.y) != EMPTY) {
+    ctx.games.Destroy();
+    return false;
+  }
+  s.world.Set(s.food.x, s.food.y, FOOD);
+  s.dir = static_cast<Dir>(dir);
+  s.inited = true;
+  resetView(ctx, s);
+  ctx.exitHold = Flow();
+  ctx.intro = Flow();
   return true;
-}
\ No newline at end of file
+}
@@ -1,6 +1,94 @@
 #pragma once
-#include "GameManager.h"
+#include "platform.h"
+#include "cell_grid.h"
 
-// Non-blocking per-frame snake
-void startSnake();
-bool stepSnake(int& outScore, bool& exitRequested, bool& gameOver);
+struct GameContext;
+class SnapWriter;
+class SnapReader;
+
+// Per-session snake state, except the world and the body, which are sized
+// by the board (SnakeBoard below)
+struct SnakeRules {
+  static constexpr int MAX_LENGTH = 64;
+  static constexpr int MAX_BIG_LENGTH = 1024;                      // big map
+  static constexpr unsigned MOVE_DELAY_MS_BASE = 200;   // Reduced from 300ms for better responsiveness
+  static constexpr int CELL = 4;                                   // pixels per grid cell
+  static constexpr int COLS = Platform::SCREEN_WIDTH / CELL;       // the viewport, and the classic world
+  static constexpr int ROWS = Platform::PLAYFIELD_HEIGHT / CELL;
+  static constexpr int BIG_COLS = 256, BIG_ROWS = 192;             // largest world
+  enum Tile : uint8_t { EMPTY, BODY, FOOD };                       // frames of Assets::SNAKE_TILES
+
+  enum Dir { RIGHT, DOWN, LEFT, UP };
+  struct Pt { int x, y; };
+  struct Seg { uint8_t x, y; };
+
+  // World size, set before the game starts. COLS x ROWS is the classic
+  // screen-sized game; anything larger is the big map, where the camera
+  // follows the head. Both wrap around at the edges.
+  int worldCols = COLS, worldRows = ROWS;
+  bool BigMap() const { return worldCols > COLS || worldRows > ROWS; }
+
+  int head = 0;                        // ring index of the head
+  int length = 0;
+
+  Dir dir = RIGHT;
+  Pt  food = {0, 0};                   // the latest food placed (the only one in classic)
+  Pt  camera = {0, 0};                 // world cell at the viewport's top-left
+  bool viewDirty = false;              // world or camera changed since the last sync
+  Raster::TileMap<COLS, ROWS> tiles;   // the viewport as drawn
+  uint64_t lastMoveTime = 0;
+  bool inited = false;
+
+  // Enhanced input handling
+  bool prevAPressed = false;
+  bool prevBPressed = false;
+  uint64_t lastInputTime = 0;
+
+  // Difficulty; host tools override it after Emplace() for tuning runs
+  unsigned moveDelayMs = MOVE_DELAY_MS_BASE;
+};
+
+// A world of up to WORLD_COLS x WORLD_ROWS cells and a body of up to
+// MAX_LEN segments, so each game carries only the board it can use
+template <int WORLD_COLS, int WORLD_ROWS, int MAX_LEN>
+struct SnakeBoard : SnakeRules {
+  static constexpr int MAX_WORLD_COLS = WORLD_COLS, MAX_WORLD_ROWS = WORLD_ROWS;
+  static constexpr int RING = MAX_LEN;
+
+  // One Tile per world cell: collisions and food are a single lookup at any
+  // world size, and only the viewport is ever rasterized
+  CellGrid<WORLD_COLS, WORLD_ROWS> world;
+
+  // Body as a ring of cells, head first: a move is a push and a pop
+  Seg ring[MAX_LEN] = {};
+  Pt  Head() const { return { ring[head].x, ring[head].y }; }
+  Pt  Segment(int i) const {           // 0 = head
+    const Seg& s = ring[(head + i) % MAX_LEN];
+    return { s.x, s.y };
+  }
+};
+
+// "1.Snake": the world is the screen
+struct SnakeState : SnakeBoard<SnakeRules::COLS, SnakeRules::ROWS, SnakeRules::MAX_LENGTH> {
+  static constexpr const char* NAME = "snake";
+  static constexpr std::size_t RAM_BUDGET = 1024;                  // game_arena.h
+};
+
+// "4.Big Snake": the same game on a world much larger than the screen, up
+// to BIG_COLS x BIG_ROWS (2-bit cells: 12 KB)
+struct BigSnakeState : SnakeBoard<SnakeRules::BIG_COLS, SnakeRules::BIG_ROWS, SnakeRules::MAX_BIG_LENGTH> {
+  static constexpr const char* NAME = "bigsnake";
+  static constexpr std::size_t RAM_BUDGET = 16 * 1024;
+  BigSnakeState() { worldCols = BIG_COLS; worldRows = BIG_ROWS; }
+};
+
+// Non-blocking per-frame snake, on whichever board the arena holds (the
+// classic one if none)
+void startSnake(GameContext& ctx);
+bool stepSnake(GameContext& ctx, int& outScore, bool& exitRequested, bool& gameOver);
+
+// Suspend snapshot payload (snapshot.h) of the classic game; Big Snake is
+// not saved. restoreSnake() builds the state in the arena and leaves it
+// empty if the bytes do not describe a valid board.
+bool snapshotSnake(const SnakeState& s, SnapWriter& w);
+bool restoreSnake(GameContext& ctx, SnapReader& r);
@@ -2,12 +2,32 @@
 #include "GameManager.h"
 // Remove "platform.h" include - it's included by GameManager.h
 
+static GameContext gGame(Platform::Default());
+
+#if BLOOP_TRACE && defined(ARDUINO)
+// Send 't' on the serial monitor for the trace, as Chrome trace-event JSON;
+// save the text between the braces to a .json file for Perfetto
+static void traceToSerial(const char* text, int n, void*) {
+  Serial.write(reinterpret_cast<const uint8_t*>(text), static_cast<size_t>(n));
+}
+
+static void pollTraceRequest() {
+  if (Serial.available() && Serial.read() == 't') Trace::WriteJson(traceToSerial, nullptr);
+}
+#endif
+
 void bloop_setup() {
-  Platform::Init();
-  Platform::ClearDisplay();
-  initGameManager();
+#if defined(ARDUINO)
+  Serial.begin(115200);   // Device::Log(), and the trace
+#endif
+  gGame.dev.Init();
+  gGame.dev.ClearDisplay();
+  initGameManager(gGame);
 }
 
 void bloop_loop() {
-  runGameLoop();
+  runGameLoop(gGame);
+#if BLOOP_TRACE && defined(ARDUINO)
+  pollTraceRequest();   // between frames, outside any traced scope
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+
+// COLS x ROWS cells of BITS bits each, packed into bytes: the storage behind
+// tile maps and grid-game worlds. A 256x192 world of 2-bit cells is 12 KB.
+template <int COLS, int ROWS, int BITS = 2>
+class CellGrid {
+public:
+  static_assert(BITS == 1 || BITS == 2 || BITS == 4 || BITS == 8, "cells must pack evenly into bytes");
+  static constexpr int CELLS = COLS * ROWS;
+  static constexpr uint8_t MASK = static_cast<uint8_t>((1 << BITS) - 1);
+
+  uint8_t Get(int col, int row) const { return At(row * COLS + col); }
+  void    Set(int col, int row, uint8_t v) { Put(row * COLS + col, v); }
+
+  // By cell index, row-major
+  uint8_t At(int i) const {
+    int bit = i * BITS;
+    return static_cast<uint8_t>((bytes_[bit >> 3] >> (bit & 7)) & MASK);
+  }
+  void Put(int i, uint8_t v) {
+    int bit = i * BITS;
+    uint8_t& b = bytes_[bit >> 3];
+    b = static_cast<uint8_t>((b & ~(MASK << (bit & 7))) | ((v & MASK) << (bit & 7)));
+  }
+
+  void Fill(uint8_t v) {
+    uint8_t b = 0;
+    for (int s = 0; s < 8; s += BITS) b |= static_cast<uint8_t>((v & MASK) << s);
+    std::memset(bytes_, b, sizeof(bytes_));
+  }
+
+private:
+  uint8_t bytes_[(CELLS * BITS + 7) / 8] = {};
+};
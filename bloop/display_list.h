@@ -0,0 +1,392 @@
+#pragma once
+#include "raster.h"
+
+#ifndef BLOOP_DISPLAY_LIST_BYTES
+  #define BLOOP_DISPLAY_LIST_BYTES 640
+#endif
+
+// Page-mode rendering: draw calls are recorded into a compact byte stream and
+// replayed once per SSD1306 page into a 128-byte buffer, so a frame never
+// needs the full 1 KB framebuffer. Output is pixel-identical to the Raster
+// functions on a full buffer.
+//
+// The list holds everything drawn since the last Clear(), because the panel
+// keeps its contents like a framebuffer does (overlays such as the exit bar
+// draw on top of the previous frame). To stay small, an opaque FillRect drops
+// earlier commands it fully covers (clears of the playfield, status bar...),
+// and a FillRect that extends the previous one is merged into it. When the
+// list is full further commands are dropped, counted in Overflows(), and
+// every page is marked: the picture is short of them until the caller
+// draws it again from a Clear() (GameManager repaints the screen).
+//
+// Every command also marks the pages it can touch, and so does dropping
+// one, so TakeChanged() is a superset of the pages whose rendering differs
+// from when it was last called: Present() replays and sends only those,
+// and skipping the rest can never lose an update.
+namespace Raster {
+
+  class DisplayList {
+  public:
+    static constexpr int CAPACITY = BLOOP_DISPLAY_LIST_BYTES;
+    static constexpr int PRUNE_MIN_AREA = 64;  // smaller fills rarely cover anything
+
+    void Clear() {
+      for (int i = 0; i < used_; i += size(buf_ + i)) mark(buf_ + i);
+      used_ = 0; last_ = -1;
+    }
+
+    // Pages that may render differently since the last call
+    uint8_t TakeChanged() {
+      uint8_t c = changed_;
+      changed_ = 0;
+      return c;
+    }
+
+    void FillRect(int x, int y, int w, int h, bool on) {
+      int x0 = x < 0 ? 0 : x, x1 = x + w > WIDTH  ? WIDTH  : x + w;
+      int y0 = y < 0 ? 0 : y, y1 = y + h > HEIGHT ? HEIGHT : y + h;
+      if (x0 >= x1 || y0 >= y1) return;
+      changed_ |= PageSpan(y0, y1);
+      if (x0 == 0 && y0 == 0 && x1 == WIDTH && y1 == HEIGHT) Clear();
+      else if ((x1 - x0) * (y1 - y0) >= PRUNE_MIN_AREA) prune(x0, y0, x1, y1);
+      if (mergeFill(x0, y0, x1, y1, on)) return;
+      uint8_t* c = reserve(5);
+      if (!c) return;
+      c[0] = op(OP_FILL, on);
+      c[1] = static_cast<uint8_t>(x0);      c[2] = static_cast<uint8_t>(y0);
+      c[3] = static_cast<uint8_t>(x1 - x0); c[4] = static_cast<uint8_t>(y1 - y0);
+      last_ = static_cast<int>(c - buf_);
+    }
+
+    void SetPixel(int x, int y, bool on) {
+      if (static_cast<unsigned>(x) >= WIDTH || static_cast<unsigned>(y) >= HEIGHT) return;
+      changed_ |= PageSpan(y, y + 1);
+      uint8_t* c = reserve(3);
+      if (!c) return;
+      c[0] = op(OP_PIXEL, on);
+      c[1] = static_cast<uint8_t>(x); c[2] = static_cast<uint8_t>(y);
+    }
+
+    // Same edges as Raster::DrawRect
+    void DrawRect(int x, int y, int w, int h, bool on) {
+      FillRect(x, y, w, 1, on);
+      if (h > 1) FillRect(x, y + h - 1, w, 1, on);
+      FillRect(x, y, 1, h, on);
+      if (w > 1) FillRect(x + w - 1, y, 1, h, on);
+    }
+
+    void DrawLine(int x0, int y0, int x1, int y1, bool on) {
+      uint8_t* c = reserve(9);
+      if (!c) return;
+      c[0] = op(OP_LINE, on);
+      put16(c + 1, x0); put16(c + 3, y0); put16(c + 5, x1); put16(c + 7, y1);
+      mark(c);
+    }
+
+    void DrawText(int x, int y, const char* t, int scale, bool on) {
+      if (scale <= 0) scale = 1;
+      if (scale > 255) scale = 255;
+      int len = 0;
+      while (t[len]) ++len;
+      uint8_t* c = reserve(6 + len + 1);
+      if (!c) return;
+      c[0] = op(OP_TEXT, on);
+      c[1] = static_cast<uint8_t>(scale);
+      put16(c + 2, x); put16(c + 4, y);
+      for (int i = 0; i <= len; ++i) c[6 + i] = static_cast<uint8_t>(t[i]);
+      mark(c);
+    }
+
+    // Stores a pointer: sprites are constexpr tables that outlive the frame.
+    // An XOR that repeats an earlier one cancels it instead, so XOR-erased
+    // movers don't grow the list.
+    void DrawSprite(int x, int y, const Sprite& s, Rop rop) {
+      if (x >= WIDTH || x + s.w <= 0 || y >= HEIGHT || y + s.h <= 0) return;
+      changed_ |= PageSpan(y, y + s.h);
+      if (rop == Rop::XOR && cancelXor(x, y, &s)) return;
+      uint8_t* c = reserve(SPRITE_BYTES);
+      if (!c) return;
+      c[0] = op(OP_SPRITE, true);
+      put16(c + 1, x); put16(c + 3, y);
+      c[5] = static_cast<uint8_t>(rop);
+      const Sprite* p = &s;
+      std::memcpy(c + 6, &p, sizeof(p));
+    }
+
+    // An opaque layer that rasterizes itself per page (bloop/tilemap.h). The
+    // object is stored by pointer and read at RenderPage() time, so the list
+    // always shows its current state; drawing it again replaces the old entry
+    // (same object, same rectangle), as any opaque fill would. dirtyPages
+    // are the pages the layer's own content changed on since its last draw.
+    //
+    // The object must outlive its entry: Clear() the list (ClearDisplay())
+    // before destroying it, as endGame() in GameManager.cpp does.
+    using BandFn = void (*)(const void* obj, uint8_t* page, int top);
+    void DrawLayer(const void* obj, BandFn fn, int x, int y, int w, int h, uint8_t dirtyPages) {
+      int x0 = x < 0 ? 0 : x, x1 = x + w > WIDTH  ? WIDTH  : x + w;
+      int y0 = y < 0 ? 0 : y, y1 = y + h > HEIGHT ? HEIGHT : y + h;
+      if (x0 >= x1 || y0 >= y1) return;
+      // Still on top of everything under its rectangle: the entry stays,
+      // and only the layer's own changes show
+      if (layerOnTop(obj, fn, x0, y0, x1, y1)) { changed_ |= dirtyPages; return; }
+      changed_ |= PageSpan(y0, y1);
+      prune(x0, y0, x1, y1);
+      uint8_t* c = reserve(LAYER_BYTES);
+      if (!c) return;
+      c[0] = op(OP_LAYER, true);
+      c[1] = static_cast<uint8_t>(x0); c[2] = static_cast<uint8_t>(y0);
+      c[3] = static_cast<uint8_t>(x1 - x0); c[4] = static_cast<uint8_t>(y1 - y0);
+      std::memcpy(c + 5, &obj, sizeof(obj));
+      std::memcpy(c + 5 + sizeof(obj), &fn, sizeof(fn));
+    }
+
+    // Replays the list into one 8-row page (WIDTH bytes, same layout as a
+    // framebuffer page)
+    void RenderPage(int page, uint8_t* out) const {
+      std::memset(out, 0, WIDTH);
+      const int top = page * 8;
+      for (int i = 0; i < used_; i += size(buf_ + i)) {
+        const uint8_t* c = buf_ + i;
+        bool on = (c[0] & ON) != 0;
+        switch (c[0] & OP_MASK) {
+          case OP_PIXEL: pixelBand(out, top, c[1], c[2], on); break;
+          case OP_FILL: FillBand(out, top, c[1], c[2], c[3], c[4], on); break;
+          case OP_LINE: lineBand(out, top, get16(c + 1), get16(c + 3), get16(c + 5), get16(c + 7), on); break;
+          case OP_TEXT: textBand(out, top, get16(c + 2), get16(c + 4), reinterpret_cast<const char*>(c + 6), c[1], on); break;
+          case OP_SPRITE: SpriteBand(out, top, get16(c + 1), get16(c + 3), *sprite(c), static_cast<Rop>(c[5])); break;
+          case OP_LAYER: layerBand(c, out, top); break;
+        }
+      }
+    }
+
+    int      Used() const      { return used_; }
+    int      HighWater() const { return highWater_; }
+    uint32_t Overflows() const { return overflows_; }
+
+  private:
+    // Encodings: PIXEL [op x y], FILL [op x y w h] (clipped), LINE [op x0 y0 x1 y1]
+    // (int16 LE), TEXT [op scale x y chars... 0] (x, y int16 LE), SPRITE [op x y
+    // rop pointer] (x, y int16 LE), LAYER [op x y w h object band-function]
+    // (clipped)
+    enum : uint8_t { OP_PIXEL = 1, OP_FILL = 2, OP_LINE = 3, OP_TEXT = 4, OP_SPRITE = 5, OP_LAYER = 6, OP_MASK = 0x7F, ON = 0x80 };
+    static constexpr int SPRITE_BYTES = 6 + static_cast<int>(sizeof(const Sprite*));
+    static constexpr int LAYER_BYTES  = 5 + static_cast<int>(sizeof(const void*) + sizeof(BandFn));
+
+    static uint8_t op(uint8_t code, bool on) { return static_cast<uint8_t>(code | (on ? ON : 0)); }
+    static void put16(uint8_t* p, int v) { p[0] = static_cast<uint8_t>(v); p[1] = static_cast<uint8_t>(v >> 8); }
+    static int  get16(const uint8_t* p) { return static_cast<int16_t>(p[0] | (p[1] << 8)); }
+    static const Sprite* sprite(const uint8_t* c) {
+      const Sprite* p;
+      std::memcpy(&p, c + 6, sizeof(p));
+      return p;
+    }
+
+    static int size(const uint8_t* c) {
+      switch (c[0] & OP_MASK) {
+        case OP_PIXEL: return 3;
+        case OP_FILL: return 5;
+        case OP_LINE: return 9;
+        case OP_SPRITE: return SPRITE_BYTES;
+        case OP_LAYER: return LAYER_BYTES;
+        default: {
+          int n = 6;
+          while (c[n]) ++n;
+          return n + 1;
+        }
+      }
+    }
+
+    // Pixels a command can touch, as [x0, x1) x [y0, y1); may be larger
+    static void bounds(const uint8_t* c, int& x0, int& y0, int& x1, int& y1) {
+      switch (c[0] & OP_MASK) {
+        case OP_PIXEL:
+          x0 = c[1]; y0 = c[2]; x1 = x0 + 1; y1 = y0 + 1;
+          return;
+        case OP_FILL: case OP_LAYER:
+          x0 = c[1]; y0 = c[2]; x1 = x0 + c[3]; y1 = y0 + c[4];
+          return;
+        case OP_SPRITE: {
+          const Sprite* s = sprite(c);
+          x0 = get16(c + 1); y0 = get16(c + 3); x1 = x0 + s->w; y1 = y0 + s->h;
+          return;
+        }
+        case OP_LINE: {
+          int ax = get16(c + 1), ay = get16(c + 3), bx = get16(c + 5), by = get16(c + 7);
+          x0 = ax < bx ? ax : bx; x1 = (ax < bx ? bx : ax) + 1;
+          y0 = ay < by ? ay : by; y1 = (ay < by ? by : ay) + 1;
+          return;
+        }
+        default: {
+          int scale = c[1], cols = 0, widest = 0, lines = 1;
+          for (const uint8_t* p = c + 6; *p; ++p) {
+            if (*p == '\n') { ++lines; cols = 0; continue; }
+            if (++cols > widest) widest = cols;
+          }
+          x0 = get16(c + 2); y0 = get16(c + 4);
+          x1 = x0 + widest * 6 * scale; y1 = y0 + lines * 8 * scale;
+          return;
+        }
+      }
+    }
+
+    uint8_t* reserve(int n) {
+      if (used_ + n > CAPACITY) {
+        overflows_++;
+        changed_ = 0xFF;
+        return nullptr;
+      }
+      uint8_t* p = buf_ + used_;
+      used_ += n;
+      if (used_ > highWater_) highWater_ = used_;
+      last_ = -1;
+      return p;
+    }
+
+    void mark(const uint8_t* c) {
+      int x0, y0, x1, y1;
+      bounds(c, x0, y0, x1, y1);
+      changed_ |= PageSpan(y0, y1);
+    }
+
+    // The same layer entry exists and nothing recorded after it overlaps it
+    bool layerOnTop(const void* obj, BandFn fn, int x0, int y0, int x1, int y1) const {
+      int found = -1;
+      for (int i = 0; i < used_; i += size(buf_ + i)) {
+        const uint8_t* c = buf_ + i;
+        if ((c[0] & OP_MASK) == OP_LAYER && c[1] == x0 && c[2] == y0 && c[3] == x1 - x0 && c[4] == y1 - y0) {
+          const void* o;
+          BandFn f;
+          std::memcpy(&o, c + 5, sizeof(o));
+          std::memcpy(&f, c + 5 + sizeof(o), sizeof(f));
+          if (o == obj && f == fn) { found = i; continue; }
+        }
+        if (found < 0) continue;
+        int bx0, by0, bx1, by1;
+        bounds(c, bx0, by0, bx1, by1);
+        if (bx0 < x1 && x0 < bx1 && by0 < y1 && y0 < by1) found = -1;
+      }
+      return found >= 0;
+    }
+
+    // Drops commands whose pixels [x0, x1) x [y0, y1) will overwrite anyway
+    void prune(int x0, int y0, int x1, int y1) {
+      int out = 0;
+      for (int i = 0; i < used_; ) {
+        int n = size(buf_ + i), bx0, by0, bx1, by1;
+        bounds(buf_ + i, bx0, by0, bx1, by1);
+        bool covered = bx0 >= x0 && by0 >= y0 && bx1 <= x1 && by1 <= y1;
+        if (!covered) {
+          if (out != i) std::memmove(buf_ + out, buf_ + i, n);
+          out += n;
+        }
+        i += n;
+      }
+      if (out != used_) last_ = -1;
+      used_ = out;
+    }
+
+    // Drops the latest identical XOR sprite if nothing drawn since overlaps
+    // it (other XORs commute with it, so they may)
+    bool cancelXor(int x, int y, const Sprite* s) {
+      int found = -1;
+      for (int i = 0; i < used_; i += size(buf_ + i)) {
+        const uint8_t* c = buf_ + i;
+        bool xorSprite = (c[0] & OP_MASK) == OP_SPRITE && static_cast<Rop>(c[5]) == Rop::XOR;
+        if (xorSprite && get16(c + 1) == x && get16(c + 3) == y && sprite(c) == s) { found = i; continue; }
+        if (found < 0 || xorSprite) continue;
+        int bx0, by0, bx1, by1;
+        bounds(c, bx0, by0, bx1, by1);
+        if (bx0 < x + s->w && x < bx1 && by0 < y + s->h && y < by1) found = -1;
+      }
+      if (found < 0) return false;
+      std::memmove(buf_ + found, buf_ + found + SPRITE_BYTES, used_ - found - SPRITE_BYTES);
+      used_ -= SPRITE_BYTES;
+      last_ = -1;
+      return true;
+    }
+
+    // Grows the previous FillRect when the new one continues it exactly
+    bool mergeFill(int x0, int y0, int x1, int y1, bool on) {
+      if (last_ < 0) return false;
+      uint8_t* c = buf_ + last_;
+      if (c[0] != op(OP_FILL, on)) return false;
+      int px0 = c[1], py0 = c[2], px1 = px0 + c[3], py1 = py0 + c[4];
+      if (py0 == y0 && py1 == y1 && (px1 == x0 || x1 == px0)) {
+        c[1] = static_cast<uint8_t>(px0 < x0 ? px0 : x0);
+        c[3] = static_cast<uint8_t>((px1 > x1 ? px1 : x1) - c[1]);
+        return true;
+      }
+      if (px0 == x0 && px1 == x1 && (py1 == y0 || y1 == py0)) {
+        c[2] = static_cast<uint8_t>(py0 < y0 ? py0 : y0);
+        c[4] = static_cast<uint8_t>((py1 > y1 ? py1 : y1) - c[2]);
+        return true;
+      }
+      return false;
+    }
+
+    // --- Band rasterizers (FillBand, SpriteBand in raster.h) ---
+    static void pixelBand(uint8_t* out, int top, int x, int y, bool on) {
+      if (static_cast<unsigned>(x) >= WIDTH || y < top || y >= top + 8) return;
+      uint8_t bit = static_cast<uint8_t>(1u << (y - top));
+      out[x] = on ? (out[x] | bit) : (out[x] & static_cast<uint8_t>(~bit));
+    }
+
+    static void layerBand(const uint8_t* c, uint8_t* out, int top) {
+      if (top + 8 <= c[2] || top >= c[2] + c[4]) return;
+      const void* obj;
+      BandFn fn;
+      std::memcpy(&obj, c + 5, sizeof(obj));
+      std::memcpy(&fn, c + 5 + sizeof(obj), sizeof(fn));
+      fn(obj, out, top);
+    }
+
+    static void lineBand(uint8_t* out, int top, int x0, int y0, int x1, int y1, bool on) {
+      if ((y0 < top && y1 < top) || (y0 >= top + 8 && y1 >= top + 8)) return;
+      int dx=std::abs(x1-x0), sx=x0<x1?1:-1;
+      int dy=-std::abs(y1-y0), sy=y0<y1?1:-1;
+      int err=dx+dy, e2;
+      while(true){
+        pixelBand(out,top,x0,y0,on);
+        if(x0==x1&&y0==y1)break;
+        e2=2*err;
+        if(e2>=dy){ err+=dy; x0+=sx; }
+        if(e2<=dx){ err+=dx; y0+=sy; }
+      }
+    }
+
+    static void textBand(uint8_t* out, int top, int x, int y, const char* t, int scale, bool on) {
+      int cx = x;
+      for (const char* p = t; *p; ++p) {
+        if (*p == '\n') { y += 8 * scale; cx = x; continue; }
+        if (y < top + 8 && y + 7 * scale > top) charBand(out, top, cx, y, *p, scale, on);
+        cx += 6 * scale;
+      }
+    }
+
+    static void charBand(uint8_t* out, int top, int x, int y, char c, int scale, bool on) {
+      if (c < 32 || c > 127) c = '?';
+      const uint8_t* g = ::FONT5x7[c - 32];
+      for (int col = 0; col < 5; ++col) {
+        uint8_t bits = g[col] & 0x7F;
+        if (scale == 1) {
+          int cx = x + col, d = y - top;
+          if (static_cast<unsigned>(cx) >= WIDTH || !bits) continue;
+          uint8_t b = static_cast<uint8_t>(d >= 0 ? bits << d : bits >> -d);
+          out[cx] = on ? (out[cx] | b) : (out[cx] & static_cast<uint8_t>(~b));
+          continue;
+        }
+        for (int row = 0; row < 7; ++row) {
+          if (bits & (1 << row)) FillBand(out, top, x + col * scale, y + row * scale, scale, scale, on);
+        }
+      }
+    }
+
+    uint8_t  buf_[CAPACITY];
+    int      used_ = 0;
+    int      last_ = -1;       // offset of a FillRect that may still be merged into
+    int      highWater_ = 0;
+    uint32_t overflows_ = 0;
+    uint8_t  changed_ = 0;     // pages touched since TakeChanged()
+  };
+
+}
@@ -0,0 +1,202 @@
+#pragma once
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#ifndef BLOOP_FLOW_SLOTS
+  #define BLOOP_FLOW_SLOTS 4
+#endif
+#ifndef BLOOP_FLOW_SLOT_BYTES
+  #define BLOOP_FLOW_SLOT_BYTES 256
+#endif
+
+// Sequential UI flows (boot, Get Ready, hold-to-exit, game over) as C++20
+// coroutines driven by the frame loop: a flow runs until it awaits
+// nextFrame() or sleepFor(ms), and the owner calls Resume(now) once per frame
+// to continue it. Nothing blocks; a sleeping flow just isn't resumed yet.
+//
+// Coroutine frames come from a FlowArena of fixed slots, never the heap. A
+// flow's first parameter must be the object holding the arena as `flows`
+// (GameContext), which also keeps sessions independent. If no slot is free
+// or a frame outgrows a slot, the flow is empty: Resume() returns false at
+// once, and the arena counts the failure.
+//
+// A flow may co_await another flow; the child runs to completion (across
+// frames) before the parent continues.
+
+// Fixed pool of coroutine frames; each slot remembers its arena so a frame
+// can be freed without one
+class FlowArena {
+public:
+  static constexpr int SLOTS      = BLOOP_FLOW_SLOTS;
+  static constexpr int SLOT_BYTES = BLOOP_FLOW_SLOT_BYTES;
+  static_assert(SLOTS <= 32, "slots are tracked in one word");
+
+  FlowArena() = default;
+  FlowArena(const FlowArena&) = delete;
+  FlowArena& operator=(const FlowArena&) = delete;
+
+  void* Allocate(std::size_t n) {
+    if (n > static_cast<std::size_t>(SLOT_BYTES)) { failures_++; return nullptr; }
+    for (int i = 0; i < SLOTS; ++i) {
+      if (used_ & (1u << i)) continue;
+      used_ |= 1u << i;
+      if (++inUse_ > highWater_) highWater_ = inUse_;
+      if (n > largest_) largest_ = static_cast<uint16_t>(n);
+      slots_[i].owner = this;
+      return slots_[i].frame;
+    }
+    failures_++;
+    return nullptr;
+  }
+
+  static void Free(void* frame) {
+    Slot* s = reinterpret_cast<Slot*>(static_cast<unsigned char*>(frame) - offsetof(Slot, frame));
+    FlowArena& a = *s->owner;
+    a.used_ &= ~(1u << static_cast<int>(s - a.slots_));
+    a.inUse_--;
+  }
+
+  int      InUse() const     { return inUse_; }
+  int      HighWater() const { return highWater_; }   // slots
+  int      Largest() const   { return largest_; }     // bytes, biggest frame seen
+  uint32_t Failures() const  { return failures_; }
+
+private:
+  struct Slot {
+    FlowArena* owner;
+    alignas(std::max_align_t) unsigned char frame[SLOT_BYTES];
+  };
+
+  Slot     slots_[SLOTS] = {};
+  uint32_t used_ = 0;
+  int      inUse_ = 0, highWater_ = 0;
+  uint16_t largest_ = 0;
+  uint32_t failures_ = 0;
+};
+
+class Flow {
+public:
+  struct promise_type;
+  using Handle = std::coroutine_handle<promise_type>;
+
+  struct promise_type {
+    promise_type* root = this;   // the flow the owner resumes
+    Handle   parent;             // flow awaiting this one
+    Handle   leaf;               // root only: innermost suspended flow
+    uint64_t now = 0;            // root only: time of the current Resume()
+    uint64_t wakeAt = 0;         // root only: not resumed before this
+
+    Flow get_return_object() noexcept {
+      Handle h = Handle::from_promise(*this);
+      leaf = h;
+      return Flow(h);
+    }
+    static Flow get_return_object_on_allocation_failure() noexcept { return Flow(); }
+
+    template <typename Owner, typename... Args>
+    static void* operator new(std::size_t n, Owner& owner, Args&...) noexcept { return owner.flows.Allocate(n); }
+    static void operator delete(void* p, std::size_t) noexcept { FlowArena::Free(p); }
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    // A child hands control straight back to its parent
+    struct Final {
+      bool await_ready() const noexcept { return false; }
+      std::coroutine_handle<> await_suspend(Handle h) noexcept {
+        promise_type& p = h.promise();
+        if (!p.parent) return std::noop_coroutine();
+        p.root->leaf = p.parent;
+        return p.parent;
+      }
+      void await_resume() const noexcept {}
+    };
+    Final final_suspend() noexcept { return {}; }
+
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { std::abort(); }
+  };
+
+  Flow() = default;
+  Flow(Flow&& o) noexcept : h_(o.h_) { o.h_ = nullptr; }
+  Flow& operator=(Flow&& o) noexcept {
+    if (this != &o) { reset(); h_ = o.h_; o.h_ = nullptr; }
+    return *this;
+  }
+  Flow(const Flow&) = delete;
+  Flow& operator=(const Flow&) = delete;
+  ~Flow() { reset(); }
+
+  bool Running() const { return static_cast<bool>(h_); }
+
+  // Continues the flow if it is due. True while it has more to do; the
+  // frame is released as soon as it finishes.
+  bool Resume(uint64_t now) {
+    if (!h_) return false;
+    promise_type& r = h_.promise();
+    r.now = now;
+    if (now >= r.wakeAt) r.leaf.resume();
+    if (!h_.done()) return true;
+    reset();
+    return false;
+  }
+
+  // co_await child: runs it now, and on later frames until it finishes
+  struct Await;
+  Await operator co_await() && noexcept;
+
+private:
+  explicit Flow(Handle h) : h_(h) {}
+  void reset() {
+    if (h_) h_.destroy();
+    h_ = nullptr;
+  }
+
+  Handle h_;
+};
+
+struct Flow::Await {
+  Flow child;
+  bool await_ready() const noexcept { return !child.h_; }
+  std::coroutine_handle<> await_suspend(Handle parent) noexcept {
+    promise_type& c = child.h_.promise();
+    c.parent = parent;
+    c.root = parent.promise().root;
+    c.root->leaf = child.h_;
+    return child.h_;
+  }
+  void await_resume() const noexcept {}
+};
+
+inline Flow::Await Flow::operator co_await() && noexcept { return Await{static_cast<Flow&&>(*this)}; }
+
+// Suspends until the flow's wake time; resumed by the first Resume() at or
+// after it (0: the next frame)
+struct FlowWait {
+  uint64_t until;
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(Flow::Handle h) noexcept {
+    Flow::promise_type& root = *h.promise().root;
+    root.leaf = h;
+    root.wakeAt = until;
+  }
+  void await_resume() const noexcept {}
+};
+
+inline FlowWait nextFrame() { return {0}; }
+inline FlowWait sleepUntil(uint64_t t) { return {t}; }
+
+// Relative to the frame the flow is running in
+struct FlowSleep {
+  uint32_t ms;
+  bool await_ready() const noexcept { return ms == 0; }
+  void await_suspend(Flow::Handle h) noexcept {
+    Flow::promise_type& root = *h.promise().root;
+    root.leaf = h;
+    root.wakeAt = root.now + ms;
+  }
+  void await_resume() const noexcept {}
+};
+
+inline FlowSleep sleepFor(uint32_t ms) { return {ms}; }
@@ -0,0 +1,91 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+
+// One block of RAM for whichever game is running, sized at compile time to
+// the largest of Games: picking a game constructs its state in place and
+// leaving it destroys it, so the games cost max(sizeof) rather than the sum.
+//
+// Every game state declares a name and a RAM budget, checked here:
+//
+//   struct BigSnakeState {
+//     static constexpr const char* NAME = "bigsnake";
+//     static constexpr std::size_t RAM_BUDGET = 16384;
+//     ...
+//
+// A state that outgrows its budget fails the build with both numbers in the
+// error (GameRamBudget<size, budget>). REPORT lists every game for tools.
+template <std::size_t Size, std::size_t Budget>
+struct GameRamBudget {
+  static_assert(Size <= Budget, "game state over its RAM_BUDGET: sizes are GameRamBudget<bytes, budget>");
+  static constexpr bool ok = true;
+};
+
+template <typename... Games>
+class GameArena {
+  static constexpr std::size_t maxOf(std::initializer_list<std::size_t> v) {
+    std::size_t m = 0;
+    for (std::size_t x : v) if (x > m) m = x;
+    return m;
+  }
+
+public:
+  static constexpr std::size_t BYTES = maxOf({sizeof(Games)...});
+  static constexpr std::size_t SUM   = (sizeof(Games) + ...);   // what separate states would take
+  static_assert((GameRamBudget<sizeof(Games), Games::RAM_BUDGET>::ok && ...));
+
+  struct Entry { const char* name; std::size_t bytes, budget; };
+  static constexpr Entry REPORT[] = { {Games::NAME, sizeof(Games), Games::RAM_BUDGET}... };
+
+  GameArena() = default;
+  GameArena(const GameArena&) = delete;
+  GameArena& operator=(const GameArena&) = delete;
+  ~GameArena() { Destroy(); }
+
+  // Ends the current game's state, if any, and builds a fresh T
+  template <typename T>
+  T& Emplace() {
+    Destroy();
+    T* t = ::new (static_cast<void*>(bytes_)) T();
+    active_ = indexOf<T>();
+    return *t;
+  }
+
+  void Destroy() {
+    int i = 0;
+    ((active_ == i++ ? ptr<Games>()->~Games() : void()), ...);
+    active_ = -1;
+  }
+
+  template <typename T> bool Holds() const { return active_ == indexOf<T>(); }
+
+  // The state if T is the one constructed, else null
+  template <typename T> T*       Get()       { return Holds<T>() ? ptr<T>() : nullptr; }
+  template <typename T> const T* Get() const { return Holds<T>() ? ptr<T>() : nullptr; }
+
+  // For game code, which only runs while its own state is live
+  template <typename T> T& As() { return *ptr<T>(); }
+
+private:
+  template <typename T>
+  static constexpr int indexOf() {
+    int i = 0, found = -1;
+    ((std::is_same_v<T, Games> ? (found = i) : 0, ++i), ...);
+    return found;
+  }
+
+  template <typename T> T* ptr() {
+    static_assert(indexOf<T>() >= 0, "not one of this arena's games");
+    return std::launder(reinterpret_cast<T*>(bytes_));
+  }
+  template <typename T> const T* ptr() const {
+    static_assert(indexOf<T>() >= 0, "not one of this arena's games");
+    return std::launder(reinterpret_cast<const T*>(bytes_));
+  }
+
+  alignas(Games...) unsigned char bytes_[BYTES];
+  int8_t active_ = -1;
+};
@@ -1,6 +1,9 @@
 #pragma once
 #include <cstdint>
 #include <cstddef>
+#include "raster.h"
+#include "tilemap.h"
+#include "trace.h"
 
 namespace Platform {
   // Screen
@@ -8,36 +11,124 @@ namespace Platform {
   static constexpr int SCREEN_HEIGHT = 64;
   static constexpr int STATUS_BAR_HEIGHT = 16;
   static constexpr int PLAYFIELD_HEIGHT  = SCREEN_HEIGHT - STATUS_BAR_HEIGHT;
+  static constexpr unsigned SCROLL_MS_PER_COLUMN = 20;  // SSD1306 hardware scroll speed
 
   // Inputs
   enum Button : int { BTN_A = 0, BTN_B = 1 };
 
-  // One-time setup (no-op on web; HW: init display/pins)
-  void Init();
+  // Storage slot for the suspend snapshot (snapshot.h)
+  static constexpr int SNAPSHOT_BYTES = 128;
 
-  // Time/Input
-  bool          ButtonPressed(Button b);
-  unsigned long Millis();
-  void          Delay(unsigned ms);
+  // xorshift32 in [min_inclusive, max_exclusive): the RNG on every target.
+  // Its whole state is one nonzero word, so a snapshot can carry it.
+  inline int RandomRange(uint32_t& state, int min_inclusive, int max_exclusive) {
+    if (max_exclusive <= min_inclusive) return min_inclusive;
+    uint32_t x = state;
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    state = x;
+    return min_inclusive + static_cast<int>(x % static_cast<uint32_t>(max_exclusive - min_inclusive));
+  }
 
-  // Speed tuning (web slows for retro vibe; HW returns 1.0)
-  float         SpeedScale();
+  // Present() skips the transfer when no draw call has changed a pixel since
+  // the last one it sent (the Raster write paths report the pages they
+  // change); both outcomes are counted
+  struct PresentStats {
+    uint32_t sent = 0;
+    uint32_t skipped = 0;
+    // Page mode only (display_list.h), 0 elsewhere: the list's fullest
+    // point, its size, and the draw calls it dropped for lack of room
+    int      listHighWater = 0;
+    int      listCapacity = 0;
+    uint32_t listOverflows = 0;
+  };
 
-  // Random
-  int           RandomInt(int min_inclusive, int max_exclusive);
+  // Handle to one console. Hardware and web have a single physical device
+  // (Default()); the host build gives every instance its own headless state.
+  // The backend is picked at compile time: the target header included at the
+  // bottom of this file defines Impl and the hot primitives inline.
+  class Device {
+  public:
+    struct Impl;  // target-defined per-instance state
 
-  // Display (monochrome)
-  void ClearDisplay();
-  void Present();
-  void DrawPixel(int x, int y, bool on=true);
-  void DrawRect(int x, int y, int w, int h, bool on=true);
-  void FillRect(int x, int y, int w, int h, bool on=true);
-  void DrawLine(int x0, int y0, int x1, int y1, bool on=true);
+    explicit Device(Impl* impl = nullptr) : impl_(impl) {}
 
-  // Text (5x7), integer scale
-  void DrawText(int x, int y, const char* text, int scale=1, bool on=true);
+    // One-time setup (web: load save blob; HW: init display/pins)
+    void Init();
 
-  // Persistent storage
-  bool StorageGet(const char* key, int& outVal);
-  void StorageSet(const char* key, int value);
+    // Time/Input. PollInput() samples the buttons once per frame (now is the
+    // frame's clock snapshot); ButtonPressed() returns that sample.
+    void          PollInput(uint64_t now);
+    bool          ButtonPressed(Button b);
+    uint64_t      Millis();   // monotonic ms since boot; 64-bit so it never wraps
+    void          Delay(unsigned ms);
+
+    // Speed tuning (web slows for retro vibe; HW returns 1.0), folded at compile time
+    static constexpr float SpeedScale();
+
+    // Random. The state can be read and put back (snapshots): the same
+    // state gives the same sequence.
+    int           RandomInt(int min_inclusive, int max_exclusive);
+    uint32_t      RandomState();
+    void          SetRandomState(uint32_t state);
+
+    // Display (monochrome)
+    void ClearDisplay();
+    void Present();
+    const PresentStats& Presents() const;
+    void DrawPixel(int x, int y, bool on=true);
+    void DrawRect(int x, int y, int w, int h, bool on=true);
+    void FillRect(int x, int y, int w, int h, bool on=true);
+    void DrawLine(int x0, int y0, int x1, int y1, bool on=true);
+    // Pre-shifted 1bpp image from bloop/assets.h, combined by a raster op;
+    // XOR draws moving objects that erase themselves when drawn again
+    void DrawSprite(int x, int y, const Raster::Sprite& s, Raster::Rop op=Raster::Rop::OR);
+    // Tile-map layer (bloop/tilemap.h): repaints the cells changed since the
+    // last call. Invalidate() the layer after drawing over it.
+    template <typename Layer> void DrawLayer(Layer& layer);
+
+    // Continuous horizontal scroll of pages [firstPage, lastPage] (8-row
+    // bands), one column per SCROLL_MS_PER_COLUMN, wrapping around. The panel
+    // does it in hardware at no CPU or bus cost; elsewhere Present() shifts the
+    // framebuffer pages. Keep calling Present() but draw nothing while it runs,
+    // and redraw after ScrollStop().
+    void ScrollStart(int firstPage, int lastPage, bool right);
+    void ScrollStop();
+
+    // Text (5x7), integer scale
+    void DrawText(int x, int y, const char* text, int scale=1, bool on=true);
+
+    // Persistent storage. StorageSet() only updates the RAM copy;
+    // StorageCommit() writes pending changes out (flash commit on hardware,
+    // blob hand-off on web) and is slow, so it runs as a background task.
+    bool StorageGet(const char* key, int& outVal);
+    void StorageSet(const char* key, int value);
+    bool StorageCommit();   // false when nothing was pending
+    // One snapshot of up to SNAPSHOT_BYTES kept beside the values and
+    // committed with them; StorageSetSnapshot(nullptr, 0) erases it
+    int  StorageGetSnapshot(uint8_t* out, int capacity);   // bytes, 0 if none
+    void StorageSetSnapshot(const uint8_t* data, int n);
+    // True when Init() found data saved by an earlier session (warm start)
+    bool HasSaveData();
+
+    // One line of diagnostics: the serial monitor (115200 baud) on
+    // hardware, the browser console on web; host sessions keep the last one
+    void Log(const char* line);
+
+    Impl* impl() const { return impl_; }
+
+  private:
+    Impl* impl_;
+  };
+
+  // The process-wide device on hardware and web
+  Device& Default();
 }
+
+// Compile-time backend selection
+#if defined(ARDUINO)
+  #include "platform_arduino.h"
+#elif defined(__EMSCRIPTEN__)
+  #include "platform_web.h"
+#else
+  #include "platform_host.h"
+#endif
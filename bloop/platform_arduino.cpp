@@ -7,51 +7,111 @@
 #include <Adafruit_SSD1306.h>
 
 // ---- CONFIG ----
-static const int PIN_BTN_A = 5;
-static const int PIN_BTN_B = 6;
+static const int PIN_BTN_A = Platform::Device::Impl::PIN_BTN_A;
+static const int PIN_BTN_B = Platform::Device::Impl::PIN_BTN_B;
 static const int OLED_RESET = -1;
 static const int OLED_ADDR  = 0x3C;
 
+#if BLOOP_PAGE_MODE
+// Page mode talks to the SSD1306 directly: the Adafruit driver would allocate
+// the 1 KB buffer this mode exists to avoid
+static uint8_t gPanelAddr = OLED_ADDR;
+static const int PANEL_CHUNK = 16;   // data bytes per I2C transaction (AVR Wire buffer is 32)
+
+static void panelCommands(const uint8_t* cmds, size_t n) {
+  Wire.beginTransmission(gPanelAddr);
+  Wire.write(static_cast<uint8_t>(0x00));   // control byte: command stream
+  Wire.write(cmds, n);
+  Wire.endTransmission();
+}
+
+static void panelWritePage(int page, const uint8_t* data) {
+  uint8_t window[6];
+  panelCommands(window, SSD1306::Window(window, page, page));
+  for (int i = 0; i < Platform::SCREEN_WIDTH; i += PANEL_CHUNK) {
+    Wire.beginTransmission(gPanelAddr);
+    Wire.write(static_cast<uint8_t>(0x40)); // control byte: data stream
+    Wire.write(data + i, PANEL_CHUNK);
+    Wire.endTransmission();
+  }
+}
+
+static void panelBegin() {
+  Wire.beginTransmission(OLED_ADDR);
+  if (Wire.endTransmission() != 0) gPanelAddr = 0x3D;   // alternative address
+  panelCommands(SSD1306::INIT, sizeof(SSD1306::INIT));
+}
+
+#else
 // Global display
 static Adafruit_SSD1306 display(Platform::SCREEN_WIDTH, Platform::SCREEN_HEIGHT, &Wire, OLED_RESET);
 
+static void panelCommands(const uint8_t* cmds, size_t n) {
+  for (size_t i = 0; i < n; ++i) display.ssd1306_command(cmds[i]);
+}
+#endif
+
 namespace Platform {
 
   // EEPROM layout (safe addresses)
   static const int EE_MAGIC_ADDR = 0;     // 2 bytes
   static const int EE_SNAKE_ADDR = 2;     // 4 bytes  
   static const int EE_PONG_ADDR  = 6;     // 4 bytes
+  static const int EE_SNAP_LEN_ADDR = 10; // 1 byte; 0 or out of range: no snapshot
+  static const int EE_SNAP_ADDR  = 11;    // SNAPSHOT_BYTES
+  static const int EE_BIGSNAKE_ADDR = EE_SNAP_ADDR + SNAPSHOT_BYTES;  // 4 bytes; erased (-1) on older saves
+  static const int EE_SIZE       = 512;
+  static_assert(EE_BIGSNAKE_ADDR + 4 <= EE_SIZE, "save slots past the EEPROM size");
   static const uint8_t MAGIC_BYTE1 = 0xB7;
   static const uint8_t MAGIC_BYTE2 = 0x10;
+  static bool gHasSave = false;
+  static bool gStorageDirty = false;
+
+  Device& Default() {
+    static Device::Impl impl;
+    static Device device(&impl);
+    return device;
+  }
 
-  void Init() {
+  void Device::Init() {
     pinMode(PIN_BTN_A, INPUT_PULLUP);
     pinMode(PIN_BTN_B, INPUT_PULLUP);
 
     Wire.begin(2,3);
+  #if BLOOP_PAGE_MODE
+    panelBegin();
+    impl_->list.Clear();
+    impl_->list.TakeChanged();
+    std::memset(impl_->page, 0, sizeof(impl_->page));
+    for (int p = 0; p < Raster::PAGES; ++p) panelWritePage(p, impl_->page);
+  #else
     if (!display.begin(SSD1306_SWITCHCAPVCC, OLED_ADDR)) {
       // If display init fails, try alternative address
       display.begin(SSD1306_SWITCHCAPVCC, 0x3D);
     }
+    impl_->fb = display.getBuffer();
     display.clearDisplay();
     display.display();
+  #endif
     
     // Seed random number generator
     #if defined(ARDUINO_ARCH_ESP32)
-      randomSeed(esp_random());
+      impl_->rng = esp_random();
     #elif defined(ARDUINO_ARCH_AVR)
-      randomSeed(analogRead(0));   // use floating analog pin
+      impl_->rng = analogRead(0) * 2654435761u ^ micros();   // use floating analog pin
     #else
-      randomSeed(micros());
+      impl_->rng = micros();
     #endif
+    if (!impl_->rng) impl_->rng = 0x9E3779B9u;
     
     // Initialize EEPROM if needed
-    EEPROM.begin(512); // For ESP32, specify size
+    EEPROM.begin(EE_SIZE); // For ESP32, specify size
     
     uint8_t m0 = EEPROM.read(EE_MAGIC_ADDR);
     uint8_t m1 = EEPROM.read(EE_MAGIC_ADDR + 1);
     
-    if (m0 != MAGIC_BYTE1 || m1 != MAGIC_BYTE2) {
+    gHasSave = (m0 == MAGIC_BYTE1 && m1 == MAGIC_BYTE2);
+    if (!gHasSave) {
       // First time setup - initialize with zeros
       EEPROM.write(EE_MAGIC_ADDR, MAGIC_BYTE1);
       EEPROM.write(EE_MAGIC_ADDR + 1, MAGIC_BYTE2);
@@ -59,6 +119,8 @@ namespace Platform {
       int zero = 0;
       EEPROM.put(EE_SNAKE_ADDR, zero);
       EEPROM.put(EE_PONG_ADDR, zero);
+      EEPROM.put(EE_BIGSNAKE_ADDR, zero);
+      EEPROM.write(EE_SNAP_LEN_ADDR, 0);
       
       #if defined(ARDUINO_ARCH_ESP32)
         EEPROM.commit(); // ESP32 requires commit
@@ -66,57 +128,56 @@ namespace Platform {
     }
   }
 
-  bool ButtonPressed(Button b) {
-    int pin = (b == Button::BTN_A) ? PIN_BTN_A : PIN_BTN_B;
-    return digitalRead(pin) == LOW; // active low
-  }
-
-  unsigned long Millis() { return ::millis(); }
-  void          Delay(unsigned ms) { ::delay(ms); }
+  bool Device::HasSaveData() { return gHasSave; }
 
-  float SpeedScale() { return 1.0f; }
+  void Device::Log(const char* line) { Serial.println(line); }
 
-  int RandomInt(int min_inclusive, int max_exclusive) {
-    if (max_exclusive <= min_inclusive) return min_inclusive;
-    long r = random((long)min_inclusive, (long)max_exclusive);
-    return (int)r;
+  // The panel scrolls by itself; the CPU and the bus are idle until it stops
+  void Device::ScrollStart(int firstPage, int lastPage, bool right) {
+    uint8_t cmd[8];
+    panelCommands(cmd, SSD1306::ScrollCommands(cmd, firstPage, lastPage, right));
   }
 
-  void ClearDisplay() { display.clearDisplay(); }
-  void Present()      { display.display(); }
-
-  void DrawPixel(int x, int y, bool on) { 
-    display.drawPixel(x, y, on ? SSD1306_WHITE : SSD1306_BLACK); 
-  }
-  
-  void DrawRect (int x, int y, int w, int h, bool on) { 
-    display.drawRect(x, y, w, h, on ? SSD1306_WHITE : SSD1306_BLACK); 
-  }
-  
-  void FillRect (int x, int y, int w, int h, bool on) { 
-    display.fillRect(x, y, w, h, on ? SSD1306_WHITE : SSD1306_BLACK); 
-  }
-  
-  void DrawLine (int x0, int y0, int x1, int y1, bool on) { 
-    display.drawLine(x0, y0, x1, y1, on ? SSD1306_WHITE : SSD1306_BLACK); 
+  // Stopping leaves the panel RAM shifted, so the next Present() resends
+  void Device::ScrollStop() {
+    const uint8_t off = SSD1306::SCROLL_OFF;
+    panelCommands(&off, 1);
+    impl_->resend = true;
   }
 
-  void DrawText(int x, int y, const char* text, int scale, bool on) {
-    display.setTextSize(scale <= 0 ? 1 : scale);
-    display.setTextColor(on ? SSD1306_WHITE : SSD1306_BLACK);
-    display.setCursor(x, y);
-    // Handle newlines manually since setCursor persists
-    for (const char* p = text; *p; ++p) {
-      if (*p == '\n') {
-        y += 8 * (scale <= 0 ? 1 : scale);
-        display.setCursor(x, y);
-      } else {
-        display.write(*p);
-      }
+#if BLOOP_PAGE_MODE
+  // Replays the display list for the pages its commands touched since the
+  // last Present() (display_list.h) and sends them; the others are as shown
+  void Device::Present() {
+    BLOOP_TRACE_SCOPE("Present");
+    uint8_t pages = impl_->list.TakeChanged();
+    if (impl_->resend) pages = 0xFF;
+    impl_->resend = false;
+    for (int p = 0; p < Raster::PAGES; ++p) {
+      if (!(pages & (1u << p))) continue;
+      impl_->list.RenderPage(p, impl_->page);
+      panelWritePage(p, impl_->page);
     }
+    if (pages) impl_->presents.sent++;
+    else       impl_->presents.skipped++;
+    impl_->presents.listHighWater = impl_->list.HighWater();
+    impl_->presents.listCapacity  = Raster::DisplayList::CAPACITY;
+    impl_->presents.listOverflows = impl_->list.Overflows();
+  }
+#else
+  // A full-frame I2C transfer only when a draw call changed a page since the
+  // last one (or a scroll shifted the panel RAM)
+  void Device::Present() {
+    BLOOP_TRACE_SCOPE("Present");
+    if (!impl_->dirty && !impl_->resend) { impl_->presents.skipped++; return; }
+    impl_->dirty = 0;
+    impl_->resend = false;
+    display.display();
+    impl_->presents.sent++;
   }
+#endif
 
-  bool StorageGet(const char* key, int& outVal) {
+  bool Device::StorageGet(const char* key, int& outVal) {
     if (!key) return false;
     
     // Verify EEPROM is still valid
@@ -139,26 +200,61 @@ namespace Platform {
       if (outVal < 0 || outVal > 99999) outVal = 0;
       return true; 
     }
+    if (strcmp(key, "hs_bigsnake") == 0) {
+      EEPROM.get(EE_BIGSNAKE_ADDR, outVal);
+      if (outVal < 0 || outVal > 99999) outVal = 0;
+      return true;
+    }
     return false;
   }
 
-  void StorageSet(const char* key, int value) {
+  void Device::StorageSet(const char* key, int value) {
     if (!key || value < 0) return;
     
     if (strcmp(key, "hs_snake") == 0) {
       EEPROM.put(EE_SNAKE_ADDR, value);
-      #if defined(ARDUINO_ARCH_ESP32)
-        EEPROM.commit();
-      #endif
+      gStorageDirty = true;
     }
     else if (strcmp(key, "hs_pong") == 0) {
       EEPROM.put(EE_PONG_ADDR, value);
-      #if defined(ARDUINO_ARCH_ESP32)
-        EEPROM.commit();
-      #endif
+      gStorageDirty = true;
+    }
+    else if (strcmp(key, "hs_bigsnake") == 0) {
+      EEPROM.put(EE_BIGSNAKE_ADDR, value);
+      gStorageDirty = true;
     }
   }
 
+  // Saves from before the snapshot slot have 0xFF there: out of range, none
+  int Device::StorageGetSnapshot(uint8_t* out, int capacity) {
+    int n = EEPROM.read(EE_SNAP_LEN_ADDR);
+    if (n == 0 || n > SNAPSHOT_BYTES || n > capacity) return 0;
+    for (int i = 0; i < n; ++i) out[i] = EEPROM.read(EE_SNAP_ADDR + i);
+    return n;
+  }
+
+  void Device::StorageSetSnapshot(const uint8_t* data, int n) {
+    if (n < 0 || n > SNAPSHOT_BYTES || (n > 0 && !data)) return;
+    int was = EEPROM.read(EE_SNAP_LEN_ADDR);
+    bool same = n == was || (n == 0 && was > SNAPSHOT_BYTES);
+    for (int i = 0; i < n && same; ++i) same = EEPROM.read(EE_SNAP_ADDR + i) == data[i];
+    if (same) return;
+    EEPROM.write(EE_SNAP_LEN_ADDR, static_cast<uint8_t>(n));
+    for (int i = 0; i < n; ++i) EEPROM.write(EE_SNAP_ADDR + i, data[i]);
+    gStorageDirty = true;
+  }
+
+  // The ESP32 EEPROM is a RAM mirror of a flash sector: commit() erases and
+  // rewrites it, tens of ms
+  bool Device::StorageCommit() {
+    if (!gStorageDirty) return false;
+    #if defined(ARDUINO_ARCH_ESP32)
+      EEPROM.commit();
+    #endif
+    gStorageDirty = false;
+    return true;
+  }
+
 } // namespace Platform
 
 #endif // ARDUINO
\ No newline at end of file
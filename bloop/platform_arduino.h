@@ -0,0 +1,100 @@
+#pragma once
+#include "platform.h"
+#include "raster.h"
+#include "display_list.h"
+#include "ssd1306.h"
+#include <Arduino.h>
+
+// Build with -DBLOOP_PAGE_MODE=1 on boards short of RAM: no 1 KB framebuffer,
+// draw calls go into a display list that Present() replays page by page
+#ifndef BLOOP_PAGE_MODE
+  #define BLOOP_PAGE_MODE 0
+#endif
+
+// Hardware: primitives rasterize straight into the SSD1306 driver's buffer
+// (same page layout), so drawing inlines into the game code.
+struct Platform::Device::Impl {
+  static constexpr int PIN_BTN_A = 5;
+  static constexpr int PIN_BTN_B = 6;
+
+#if BLOOP_PAGE_MODE
+  Raster::DisplayList list;
+  uint8_t  page[Raster::WIDTH] = {};      // one page, sent as soon as it is rendered
+#else
+  uint8_t* fb = nullptr;   // display.getBuffer(), set by Init()
+  uint8_t  dirty = 0;      // pages the draw calls changed since the last Present()
+#endif
+  PresentStats presents;
+  bool     resend = false;     // hardware scroll moved the panel RAM; send the next frame
+  bool     buttons[2] = {false, false};  // sampled by PollInput()
+  uint32_t rng = 0x9E3779B9u;  // xorshift32 state, seeded by Init()
+
+  // 32-bit millis() extension for cores without a 64-bit timer
+  uint32_t lastMillis = 0;
+  uint32_t millisHigh = 0;
+};
+
+namespace Platform {
+
+  inline void Device::PollInput(uint64_t) {
+    impl_->buttons[BTN_A] = digitalRead(Impl::PIN_BTN_A) == LOW; // active low
+    impl_->buttons[BTN_B] = digitalRead(Impl::PIN_BTN_B) == LOW;
+  }
+  inline bool Device::ButtonPressed(Button b) { return impl_->buttons[static_cast<int>(b)]; }
+
+  inline uint64_t Device::Millis() {
+  #if defined(ARDUINO_ARCH_ESP32)
+    return static_cast<uint64_t>(esp_timer_get_time() / 1000);
+  #else
+    // millis() wraps after ~49 days; carry into the high word. Read at least
+    // once per frame, so a wrap can never be missed.
+    uint32_t m = ::millis();
+    if (m < impl_->lastMillis) impl_->millisHigh++;
+    impl_->lastMillis = m;
+    return (static_cast<uint64_t>(impl_->millisHigh) << 32) | m;
+  #endif
+  }
+  inline void Device::Delay(unsigned ms) { ::delay(ms); }
+
+  constexpr float Device::SpeedScale() { return 1.0f; }
+
+  inline int Device::RandomInt(int min_inclusive, int max_exclusive) {
+    return RandomRange(impl_->rng, min_inclusive, max_exclusive);
+  }
+  inline uint32_t Device::RandomState()          { return impl_->rng; }
+  inline void Device::SetRandomState(uint32_t s) { if (s) impl_->rng = s; }
+
+  inline const PresentStats& Device::Presents() const { return impl_->presents; }
+
+#if BLOOP_PAGE_MODE
+  inline void Device::ClearDisplay() { impl_->list.Clear(); }
+
+  inline void Device::DrawPixel(int x, int y, bool on)                { impl_->list.SetPixel(x, y, on); }
+  inline void Device::DrawRect(int x, int y, int w, int h, bool on)   { impl_->list.DrawRect(x, y, w, h, on); }
+  inline void Device::FillRect(int x, int y, int w, int h, bool on)   { impl_->list.FillRect(x, y, w, h, on); }
+  inline void Device::DrawLine(int x0, int y0, int x1, int y1, bool on) { impl_->list.DrawLine(x0, y0, x1, y1, on); }
+  inline void Device::DrawSprite(int x, int y, const Raster::Sprite& s, Raster::Rop op) { impl_->list.DrawSprite(x, y, s, op); }
+  // The list replays the layer's current cells every page, so nothing stays
+  // dirty once the pages they are on have been marked for sending
+  template <typename Layer> inline void Device::DrawLayer(Layer& l) {
+    impl_->list.DrawLayer(&l, &Layer::Band, l.X(), l.Y(), l.Width(), l.Height(), l.DirtyPages());
+    l.ClearDirty();
+  }
+  inline void Device::DrawText(int x, int y, const char* text, int scale, bool on) {
+    impl_->list.DrawText(x, y, text, scale, on);
+  }
+#else
+  inline void Device::ClearDisplay() { impl_->dirty |= Raster::Clear(impl_->fb); }
+
+  inline void Device::DrawPixel(int x, int y, bool on)                { impl_->dirty |= Raster::SetPixel(impl_->fb, x, y, on); }
+  inline void Device::DrawRect(int x, int y, int w, int h, bool on)   { impl_->dirty |= Raster::DrawRect(impl_->fb, x, y, w, h, on); }
+  inline void Device::FillRect(int x, int y, int w, int h, bool on)   { impl_->dirty |= Raster::FillRect(impl_->fb, x, y, w, h, on); }
+  inline void Device::DrawLine(int x0, int y0, int x1, int y1, bool on) { impl_->dirty |= Raster::DrawLine(impl_->fb, x0, y0, x1, y1, on); }
+  inline void Device::DrawSprite(int x, int y, const Raster::Sprite& s, Raster::Rop op) { impl_->dirty |= Raster::DrawSprite(impl_->fb, x, y, s, op); }
+  template <typename Layer> inline void Device::DrawLayer(Layer& l) { impl_->dirty |= l.Draw(impl_->fb); }
+  inline void Device::DrawText(int x, int y, const char* text, int scale, bool on) {
+    impl_->dirty |= Raster::DrawText(impl_->fb, x, y, text, scale, on);
+  }
+#endif
+
+} // namespace Platform
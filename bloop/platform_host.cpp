@@ -0,0 +1,116 @@
+#if !defined(ARDUINO) && !defined(__EMSCRIPTEN__)
+
+#include "platform.h"
+#include "ssd1306.h"
+#include <cstring>
+
+namespace Platform {
+
+  // Host builds have no physical console; Default() is a single headless one
+  Device& Default() {
+    static Device::Impl impl;
+    static Device device(&impl);
+    return device;
+  }
+
+  void Device::Init() {
+    impl_->hasSave = impl_->storeCount > 0;
+    // Setup, then the cleared frame the hardware sends
+    impl_->Charge(impl_->costs.initUs + uint64_t(Impl::FRAME_BUS_BYTES) * impl_->costs.busUsPerByte);
+    if (impl_->panel) impl_->panel->Command(SSD1306::INIT, sizeof(SSD1306::INIT), impl_->now);
+  }
+
+  // Hardware path: the whole frame when it changed or the panel RAM was
+  // scrolled, nothing otherwise
+  void PresentPanel(Device::Impl& im) {
+    if (im.dirty || im.resend) {
+      uint8_t win[6];
+      im.panel->Command(win, SSD1306::Window(win, 0, Raster::PAGES - 1), im.now);
+      im.panel->Data(im.fb, Device::Impl::FB_BYTES, im.now);
+      im.resend = false;
+      im.dirty = 0;
+      im.presents.sent++;
+      im.Charge(uint64_t(Device::Impl::FRAME_BUS_BYTES) * im.costs.busUsPerByte);
+    } else {
+      im.presents.skipped++;
+    }
+    im.panel->Frame(im.now);
+  }
+
+  void Device::ScrollStart(int firstPage, int lastPage, bool right) {
+    if (impl_->panel) {
+      uint8_t cmd[8];
+      impl_->panel->Command(cmd, SSD1306::ScrollCommands(cmd, firstPage, lastPage, right), impl_->now);
+      return;
+    }
+    impl_->scroll.Start(firstPage, lastPage, right, SCROLL_MS_PER_COLUMN, impl_->now);
+  }
+
+  void Device::ScrollStop() {
+    if (impl_->panel) {
+      const uint8_t off = SSD1306::SCROLL_OFF;
+      impl_->panel->Command(&off, 1, impl_->now);
+      impl_->resend = true;
+      return;
+    }
+    impl_->scroll.Stop();
+  }
+
+  bool Device::HasSaveData() { return impl_->hasSave; }
+
+  void Device::Log(const char* line) {
+    std::strncpy(impl_->lastLog, line, sizeof(impl_->lastLog) - 1);
+    impl_->logLines++;
+  }
+
+  bool Device::StorageGet(const char* key, int& outVal) {
+    if (!key) return false;
+    for (int i = 0; i < impl_->storeCount; ++i) {
+      if (std::strncmp(impl_->store[i].key, key, Impl::KEY_LEN) == 0) {
+        outVal = impl_->store[i].value;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void Device::StorageSet(const char* key, int value) {
+    if (!key || value < 0 || std::strlen(key) >= Impl::KEY_LEN) return;
+    for (int i = 0; i < impl_->storeCount; ++i) {
+      if (std::strncmp(impl_->store[i].key, key, Impl::KEY_LEN) == 0) {
+        impl_->store[i].value = value;
+        impl_->storeDirty = true;
+        return;
+      }
+    }
+    if (impl_->storeCount >= Impl::MAX_KEYS) return;
+    Impl::Entry& e = impl_->store[impl_->storeCount++];
+    std::strncpy(e.key, key, Impl::KEY_LEN);
+    e.value = value;
+    impl_->storeDirty = true;
+  }
+
+  int Device::StorageGetSnapshot(uint8_t* out, int capacity) {
+    if (impl_->snapshotLen == 0 || impl_->snapshotLen > capacity) return 0;
+    std::memcpy(out, impl_->snapshot, static_cast<size_t>(impl_->snapshotLen));
+    return impl_->snapshotLen;
+  }
+
+  void Device::StorageSetSnapshot(const uint8_t* data, int n) {
+    if (n < 0 || n > SNAPSHOT_BYTES || (n > 0 && !data)) return;
+    if (n == impl_->snapshotLen && (n == 0 || std::memcmp(impl_->snapshot, data, static_cast<size_t>(n)) == 0)) return;
+    if (n > 0) std::memcpy(impl_->snapshot, data, static_cast<size_t>(n));
+    impl_->snapshotLen = n;
+    impl_->storeDirty = true;
+  }
+
+  bool Device::StorageCommit() {
+    if (!impl_->storeDirty) return false;
+    impl_->storeDirty = false;
+    impl_->commits++;
+    return true;
+  }
+
+} // namespace Platform
+
+#endif // !ARDUINO && !__EMSCRIPTEN__
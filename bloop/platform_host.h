@@ -0,0 +1,108 @@
+#pragma once
+#include "platform.h"
+#include "raster.h"
+
+namespace Platform {
+  // Receives the SSD1306 byte stream the hardware backend would send
+  // (host/panel_model.h). With one attached, the session drives it the way
+  // platform_arduino.cpp drives the real panel, scrolling included.
+  struct PanelSink {
+    virtual ~PanelSink() = default;
+    virtual void Command(const uint8_t* bytes, int n, uint64_t now) = 0;
+    virtual void Data(const uint8_t* bytes, int n, uint64_t now) = 0;
+    virtual void Frame(uint64_t now) = 0;  // a Present() happened
+  };
+}
+
+// Headless per-instance state for host builds (runners, tools). Each
+// Platform::Device created with one of these is a fully independent console.
+struct Platform::Device::Impl {
+  static constexpr int FB_BYTES  = Raster::BYTES;
+  static constexpr int MAX_KEYS  = 8;
+  static constexpr int KEY_LEN   = 12;
+
+  uint8_t  fb[FB_BYTES] = {};          // SSD1306 page layout: 8 rows per byte, LSB top
+  uint8_t  dirty = 0;                  // pages the draw calls changed since the last Present()
+  bool     buttons[2] = {false, false}; // set by the driver between frames
+  uint64_t now = 0;                    // virtual clock in ms, advanced by Delay()
+  uint32_t rng = 0x9E3779B9u;          // xorshift32 state, seed per session
+  PresentStats presents;
+  Raster::Scroller scroll;             // software scroll, when no panel is attached
+  PanelSink* panel = nullptr;          // optional hardware model
+  bool     resend = false;             // panel RAM was scrolled; send the next frame
+
+  struct Entry { char key[KEY_LEN]; int value; };
+  Entry    store[MAX_KEYS] = {};
+  int      storeCount = 0;
+  bool     storeDirty = false;         // set since the last StorageCommit()
+  uint32_t commits = 0;                // StorageCommit() calls that wrote
+  uint8_t  snapshot[SNAPSHOT_BYTES] = {};
+  int      snapshotLen = 0;
+  bool     hasSave = false;
+  char     lastLog[128] = {};          // Log(), for the tools to print
+  uint32_t logLines = 0;
+
+  // Device time charged to the virtual clock, for tools that time power-on
+  // (resume_check); all zero, only Delay() moves it
+  struct Costs {
+    uint32_t initUs = 0;               // Init(): bus, panel and EEPROM setup
+    uint32_t busUsPerByte = 0;         // each byte a frame sends to the panel
+  };
+  Costs    costs;
+  uint32_t chargedUs = 0;              // charged but not yet a whole ms
+
+  void Charge(uint64_t us) {
+    us += chargedUs;
+    now += us / 1000;
+    chargedUs = static_cast<uint32_t>(us % 1000);
+  }
+  // A full frame as the hardware backend sends it: window commands and 1 KB
+  static constexpr int FRAME_BUS_BYTES = 7 + FB_BYTES + 1;
+};
+
+namespace Platform {
+
+  void PresentPanel(Device::Impl& impl);
+
+  // The driver writes buttons between frames, so they already are the sample
+  inline void Device::PollInput(uint64_t)     {}
+  inline bool Device::ButtonPressed(Button b) { return impl_->buttons[static_cast<int>(b)]; }
+  inline uint64_t Device::Millis()            { return impl_->now; }
+
+  // Virtual time: waiting simply advances the session clock
+  inline void Device::Delay(unsigned ms) { impl_->now += ms; }
+
+  constexpr float Device::SpeedScale() { return 1.0f; }
+
+  inline int Device::RandomInt(int min_inclusive, int max_exclusive) {
+    return RandomRange(impl_->rng, min_inclusive, max_exclusive);
+  }
+  inline uint32_t Device::RandomState()          { return impl_->rng; }
+  inline void Device::SetRandomState(uint32_t s) { if (s) impl_->rng = s; }
+
+  inline void Device::ClearDisplay() { impl_->dirty |= Raster::Clear(impl_->fb); }
+  inline void Device::Present() {
+    BLOOP_TRACE_SCOPE("Present");
+    if (impl_->panel) { PresentPanel(*impl_); return; }
+    impl_->dirty |= impl_->scroll.Apply(impl_->fb, impl_->now);
+    if (impl_->dirty) {
+      impl_->presents.sent++;
+      if (impl_->costs.busUsPerByte) impl_->Charge(uint64_t(Impl::FRAME_BUS_BYTES) * impl_->costs.busUsPerByte);
+    } else {
+      impl_->presents.skipped++;
+    }
+    impl_->dirty = 0;
+  }
+  inline const PresentStats& Device::Presents() const { return impl_->presents; }
+
+  inline void Device::DrawPixel(int x, int y, bool on)                { impl_->dirty |= Raster::SetPixel(impl_->fb, x, y, on); }
+  inline void Device::DrawRect(int x, int y, int w, int h, bool on)   { impl_->dirty |= Raster::DrawRect(impl_->fb, x, y, w, h, on); }
+  inline void Device::FillRect(int x, int y, int w, int h, bool on)   { impl_->dirty |= Raster::FillRect(impl_->fb, x, y, w, h, on); }
+  inline void Device::DrawLine(int x0, int y0, int x1, int y1, bool on) { impl_->dirty |= Raster::DrawLine(impl_->fb, x0, y0, x1, y1, on); }
+  inline void Device::DrawSprite(int x, int y, const Raster::Sprite& s, Raster::Rop op) { impl_->dirty |= Raster::DrawSprite(impl_->fb, x, y, s, op); }
+  template <typename Layer> inline void Device::DrawLayer(Layer& l) { impl_->dirty |= l.Draw(impl_->fb); }
+  inline void Device::DrawText(int x, int y, const char* text, int scale, bool on) {
+    impl_->dirty |= Raster::DrawText(impl_->fb, x, y, text, scale, on);
+  }
+
+} // namespace Platform
@@ -1,144 +1,252 @@
-#ifndef ARDUINO
+#ifdef __EMSCRIPTEN__
 
 #include "platform.h"
-#include "font5x7.h"
+#include <cstddef>
 #include <cstdlib>
-#include <ctime>
-#include <thread>
-#include <chrono>
-#include <cmath>
 #include <cstring>
 #include <emscripten.h>
+#ifdef __wasm_simd128__
+  #include <wasm_simd128.h>
+#endif
 
 extern "C" {
-  void   js_draw_pixel(int x, int y, int color);
-  void   js_display();
-  void   js_clear_display();
-  int    js_button_pressed(int pin);
-  double js_now();
+  void   js_display(const uint32_t* rgba, int x, int y, int w, int h);
+  int    js_save_load(uint8_t* dst, int capacity);
+  void   js_save_schedule(const uint8_t* src, int size);
+  void   js_input_attach(InputRing* ring, const Platform::PresentStats* presents);
 }
 
+static_assert(sizeof(InputRing::Edge) == 16 && offsetof(InputRing, edges) == 32,
+              "InputRing layout is mirrored in js_input_attach");
+
 namespace Platform {
 
-  void Init() { /* web: nothing to init */ }
+  static void loadSave();
+  static bool gHasSave = false;
+
+  Device& Default() {
+    static Device::Impl impl;
+    static Device device(&impl);
+    return device;
+  }
 
-  bool ButtonPressed(Button b) { return js_button_pressed(static_cast<int>(b)) != 0; }
-  unsigned long Millis()       { return static_cast<unsigned long>(js_now()); }
-  
-  // Non-blocking delay for web - just sleep the thread briefly
-  void Delay(unsigned ms) { 
-    if (ms > 0) {
-      std::this_thread::sleep_for(std::chrono::milliseconds(ms)); 
+  void Device::Init() {
+    impl_->rng = static_cast<uint32_t>(emscripten_random() * 4294967295.0) | 1u;
+    loadSave();
+    js_input_attach(&impl_->input, &impl_->presents);
+  }
+
+  // ---- Display ----
+  // Expands row y of a page-layout framebuffer into opaque black/white RGBA8
+  static void expandRow(const uint8_t* fb, uint32_t* rgba, int y) {
+    const uint8_t* page = fb + (y >> 3) * Raster::WIDTH;
+    const uint8_t  bit  = static_cast<uint8_t>(1u << (y & 7));
+    uint32_t* out = rgba + y * Raster::WIDTH;
+  #ifdef __wasm_simd128__
+    // 16 columns per step: byte mask -> sign-extend to four i32x4 -> OR alpha
+    const v128_t sel   = wasm_i8x16_splat(static_cast<int8_t>(bit));
+    const v128_t alpha = wasm_i32x4_splat(static_cast<int32_t>(0xFF000000u));
+    for (int x = 0; x < Raster::WIDTH; x += 16) {
+      v128_t on = wasm_i8x16_ne(wasm_v128_and(wasm_v128_load(page + x), sel), wasm_i8x16_splat(0));
+      v128_t lo = wasm_i16x8_extend_low_i8x16(on);
+      v128_t hi = wasm_i16x8_extend_high_i8x16(on);
+      wasm_v128_store(out + x,      wasm_v128_or(wasm_i32x4_extend_low_i16x8(lo),  alpha));
+      wasm_v128_store(out + x + 4,  wasm_v128_or(wasm_i32x4_extend_high_i16x8(lo), alpha));
+      wasm_v128_store(out + x + 8,  wasm_v128_or(wasm_i32x4_extend_low_i16x8(hi),  alpha));
+      wasm_v128_store(out + x + 12, wasm_v128_or(wasm_i32x4_extend_high_i16x8(hi), alpha));
     }
+  #else
+    for (int x = 0; x < Raster::WIDTH; ++x) out[x] = (page[x] & bit) ? 0xFFFFFFFFu : 0xFF000000u;
+  #endif
   }
 
-  // Reduce speed scaling for smoother web gameplay
-  float SpeedScale() { return 1.0f; }  // Reduced from 3.0f
+  // Diffs the pages the draw calls touched against the last presented frame,
+  // expands only the rows that changed and hands the page the dirty
+  // rectangle. Nothing changed: no call.
+  void Device::Present() {
+    BLOOP_TRACE_SCOPE("Present");
+    Impl& im = *impl_;
+    im.dirty |= im.scroll.Apply(im.fb, Millis());
+    const uint8_t dirty = im.shownValid ? im.dirty : 0xFF;
+    im.dirty = 0;
+    int x0 = Raster::WIDTH, x1 = -1, y0 = Raster::HEIGHT, y1 = -1;
+    for (int p = 0; p < Raster::PAGES; ++p) {
+      if (!(dirty & (1u << p))) continue;
+      const uint8_t* cur  = im.fb    + p * Raster::WIDTH;
+      const uint8_t* prev = im.shown + p * Raster::WIDTH;
+      unsigned rows = 0;
+      for (int x = 0; x < Raster::WIDTH; ++x) {
+        unsigned d = im.shownValid ? (cur[x] ^ prev[x]) : 0xFFu;  // first present: everything
+        if (!d) continue;
+        rows |= d;
+        if (x < x0) x0 = x;
+        if (x > x1) x1 = x;
+      }
+      for (unsigned r = rows; r; r &= r - 1) expandRow(im.fb, im.rgba, p * 8 + __builtin_ctz(r));
+      if (rows) {
+        if (y0 == Raster::HEIGHT) y0 = p * 8 + __builtin_ctz(rows);
+        y1 = p * 8 + 31 - __builtin_clz(rows);
+      }
+    }
+    if (x1 < 0) { im.presents.skipped++; return; }
+    std::memcpy(im.shown, im.fb, Impl::FB_BYTES);
+    im.shownValid = true;
+    im.presents.sent++;
+    js_display(im.rgba, x0, y0, x1 - x0 + 1, y1 - y0 + 1);
+  }
 
-  int RandomInt(int min_inclusive, int max_exclusive) {
-    static bool seeded = false;
-    if (!seeded) { std::srand(static_cast<unsigned>(Millis())); seeded = true; }
-    if (max_exclusive <= min_inclusive) return min_inclusive;
-    return min_inclusive + (std::rand() % (max_exclusive - min_inclusive));
+  // Applies queued edges in order, at most one transition per button per
+  // frame: a tap shorter than a frame still shows up as one pressed frame,
+  // and anything after it waits for the next frame.
+  void Device::PollInput(uint64_t now) {
+    InputRing& r = impl_->input;
+    bool changed[2] = {false, false};
+    for (; r.tail != r.head; ++r.tail) {
+      const InputRing::Edge& e = r.edges[r.tail & (InputRing::CAPACITY - 1)];
+      int  b    = e.button & 1;
+      bool down = e.down != 0;
+      if (down == impl_->buttons[b]) continue;
+      if (changed[b]) break;
+      impl_->buttons[b] = down;
+      changed[b] = true;
+
+      double lat = static_cast<double>(now) - e.timeMs;
+      if (lat < 0) lat = 0;
+      r.latencySumMs += lat;
+      if (lat > r.latencyMaxMs) r.latencyMaxMs = lat;
+      r.latencyCount++;
+    }
   }
 
-  void ClearDisplay() { js_clear_display(); }
-  void Present()      { js_display(); }
+  bool Device::HasSaveData() { return gHasSave; }
 
-  void DrawPixel(int x,int y,bool on){
-    if(x<0||y<0||x>=SCREEN_WIDTH||y>=SCREEN_HEIGHT) return;
-    js_draw_pixel(x,y,on?1:0);
+  void Device::Log(const char* line) {
+    EM_ASM({ console.log(UTF8ToString($0)); }, line);
   }
 
-  void DrawRect(int x,int y,int w,int h,bool on){
-    for (int i=0;i<w;++i){ 
-      DrawPixel(x+i,y,on); 
-      if (h > 1) DrawPixel(x+i,y+h-1,on); 
-    }
-    for (int j=0;j<h;++j){ 
-      DrawPixel(x,y+j,on); 
-      if (w > 1) DrawPixel(x+w-1,y+j,on); 
-    }
+  // Busy-wait on the high-resolution clock; keeps <thread>/<chrono> out of the bundle
+  void Device::Delay(unsigned ms) {
+    if (ms == 0) return;
+    double until = emscripten_get_now() + ms;
+    while (emscripten_get_now() < until) {}
+  }
+
+  // ---- Persistent storage ----
+  // All persistent data lives in one versioned binary blob in WASM memory.
+  // index.html loads it asynchronously before main() runs and writes it back
+  // lazily (idle callback / visibilitychange / pagehide) as a single
+  // localStorage entry, so StorageGet/StorageSet never cross into JS.
+  static constexpr uint32_t SAVE_MAGIC       = 0x504F4C42; // "BLOP"
+  static constexpr uint16_t SAVE_VERSION     = 2;   // 2: snapshot slot appended
+  static constexpr int      SAVE_MAX_ENTRIES = 8;
+  static constexpr int      SAVE_KEY_LEN     = 12;
+
+  struct SaveEntry { char key[SAVE_KEY_LEN]; int32_t value; };
+  struct SaveBlob {
+    uint32_t  magic;
+    uint16_t  version;
+    uint16_t  count;
+    SaveEntry entries[SAVE_MAX_ENTRIES];
+    uint16_t  snapshotLen;
+    uint8_t   snapshot[SNAPSHOT_BYTES];
+  };
+  static constexpr int SAVE_V1_BYTES = static_cast<int>(offsetof(SaveBlob, snapshotLen));
+
+  static SaveBlob gSave;
+  static bool     gSaveDirty = false;
+
+  static void resetSave() {
+    std::memset(&gSave, 0, sizeof(gSave));
+    gSave.magic   = SAVE_MAGIC;
+    gSave.version = SAVE_VERSION;
   }
 
-  void FillRect(int x,int y,int w,int h,bool on){
-    for (int j=0;j<h;++j)
-      for (int i=0;i<w;++i)
-        DrawPixel(x+i,y+j,on);
+  static bool saveValid() {
+    return gSave.magic == SAVE_MAGIC && gSave.version == SAVE_VERSION &&
+           gSave.count <= SAVE_MAX_ENTRIES;
   }
 
-  void DrawLine(int x0,int y0,int x1,int y1,bool on){
-    int dx=std::abs(x1-x0), sx=x0<x1?1:-1;
-    int dy=-std::abs(y1-y0), sy=y0<y1?1:-1;
-    int err=dx+dy, e2;
-    while(true){
-      DrawPixel(x0,y0,on);
-      if(x0==x1&&y0==y1)break;
-      e2=2*err;
-      if(e2>=dy){ err+=dy; x0+=sx; }
-      if(e2<=dx){ err+=dx; y0+=sy; }
+  static SaveEntry* findEntry(const char* key) {
+    for (int i = 0; i < gSave.count; ++i) {
+      if (std::strncmp(gSave.entries[i].key, key, SAVE_KEY_LEN) == 0) return &gSave.entries[i];
     }
+    return nullptr;
   }
 
-  // 5x7 text rasterizer
-  static void DrawChar(int x,int y,char c,int scale,bool on){
-    if(c<32||c>127) c='?';
-    const uint8_t* g = ::FONT5x7[c-32];
-    for(int col=0; col<5; ++col){
-      uint8_t bits=g[col];
-      for(int row=0; row<7; ++row){
-        if(bits&(1<<row)){
-          for(int dx=0; dx<scale; ++dx)
-            for(int dy=0; dy<scale; ++dy)
-              DrawPixel(x+col*scale+dx, y+row*scale+dy, on);
-        }
-      }
+  // One-time import of the per-key localStorage values written by older builds
+  static void importLegacyKeys() {
+    static const char* const kLegacy[] = { "hs_snake", "hs_pong" };
+    for (const char* key : kLegacy) {
+      int v = EM_ASM_INT({
+        try {
+          var s = localStorage.getItem(UTF8ToString($0));
+          var val = (s === null) ? NaN : parseInt(s, 10);
+          return isNaN(val) ? -1 : val;
+        } catch(e) { return -1; }
+      }, key);
+      if (v >= 0) Default().StorageSet(key, v);
     }
   }
 
-  void DrawText(int x,int y,const char* t,int scale,bool on){
-    int cx=x;
-    for(const char* p=t; *p; ++p){
-      if(*p=='\n'){ y+=8*scale; cx=x; continue; }
-      DrawChar(cx,y,*p,scale,on);
-      cx+=6*scale;
+  static void loadSave() {
+    int n = js_save_load(reinterpret_cast<uint8_t*>(&gSave), static_cast<int>(sizeof(gSave)));
+    if (n == static_cast<int>(sizeof(gSave)) && saveValid()) { gHasSave = true; return; }
+    // Version 1 is the same blob without the snapshot
+    if (n == SAVE_V1_BYTES && gSave.magic == SAVE_MAGIC && gSave.version == 1 && gSave.count <= SAVE_MAX_ENTRIES) {
+      gSave.version = SAVE_VERSION;
+      gSave.snapshotLen = 0;
+      gHasSave = true;
+      return;
     }
+    resetSave();
+    importLegacyKeys();
+    gHasSave = gSave.count > 0;
   }
 
-  // Storage via localStorage with better error handling
-  bool StorageGet(const char* key, int& outVal) {
-    int ok = EM_ASM_INT({
-      var k = UTF8ToString($0);
-      try {
-        if (typeof localStorage === 'undefined') return 0;
-        var s = localStorage.getItem(k);
-        if (s === null || s === undefined) return 0;
-        var val = parseInt(s, 10);
-        if (isNaN(val)) return 0;
-        setValue($1, val, 'i32');
-        return 1;
-      } catch(e) {
-        console.warn('Storage error:', e);
-        return 0;
-      }
-    }, key, &outVal);
-    return ok != 0;
-  }
-
-  void StorageSet(const char* key, int value) {
-    EM_ASM({
-      var k = UTF8ToString($0);
-      var v = $1|0;
-      try {
-        if (typeof localStorage !== 'undefined' && v >= 0) {
-          localStorage.setItem(k, v.toString());
-        }
-      } catch(e) {
-        console.warn('Storage save error:', e);
-      }
-    }, key, value);
+  bool Device::StorageGet(const char* key, int& outVal) {
+    if (!key) return false;
+    const SaveEntry* e = findEntry(key);
+    if (!e) return false;
+    outVal = e->value;
+    return true;
+  }
+
+  void Device::StorageSet(const char* key, int value) {
+    if (!key || value < 0 || std::strlen(key) >= SAVE_KEY_LEN) return;
+    SaveEntry* e = findEntry(key);
+    if (!e) {
+      if (gSave.count >= SAVE_MAX_ENTRIES) return;
+      e = &gSave.entries[gSave.count++];
+      std::strncpy(e->key, key, SAVE_KEY_LEN);
+    } else if (e->value == value) {
+      return;
+    }
+    e->value = value;
+    gSaveDirty = true;
+  }
+
+  int Device::StorageGetSnapshot(uint8_t* out, int capacity) {
+    int n = gSave.snapshotLen;
+    if (n == 0 || n > SNAPSHOT_BYTES || n > capacity) return 0;
+    std::memcpy(out, gSave.snapshot, static_cast<size_t>(n));
+    return n;
+  }
+
+  void Device::StorageSetSnapshot(const uint8_t* data, int n) {
+    if (n < 0 || n > SNAPSHOT_BYTES || (n > 0 && !data)) return;
+    if (n == gSave.snapshotLen && (n == 0 || std::memcmp(gSave.snapshot, data, static_cast<size_t>(n)) == 0)) return;
+    if (n > 0) std::memcpy(gSave.snapshot, data, static_cast<size_t>(n));
+    gSave.snapshotLen = static_cast<uint16_t>(n);
+    gSaveDirty = true;
+  }
+
+  bool Device::StorageCommit() {
+    if (!gSaveDirty) return false;
+    js_save_schedule(reinterpret_cast<const uint8_t*>(&gSave), static_cast<int>(sizeof(gSave)));
+    gSaveDirty = false;
+    return true;
   }
 
 } // namespace Platform
 
-#endif // ARDUINO
\ No newline at end of file
+#endif // __EMSCRIPTEN__
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+#include "platform.h"
+#include "raster.h"
+
+extern "C" {
+  double js_now();
+}
+
+// Button edges in WASM memory. worker.js appends one as each key/touch event
+// arrives (timestamped on the Millis() clock); PollInput() drains them at the
+// top of the frame, so reading input never crosses into JS. The layout is
+// mirrored by the writer in js_input_attach (web/main.cpp).
+struct InputRing {
+  static constexpr uint32_t CAPACITY = 32;  // power of two
+
+  struct Edge {
+    double  timeMs;
+    int32_t button;
+    int32_t down;
+  };
+
+  uint32_t head = 0;           // next slot, advanced by JS
+  uint32_t tail = 0;           // next unread slot, advanced by C++
+  uint32_t dropped = 0;        // edges JS discarded because the ring was full
+  uint32_t latencyCount = 0;   // edges applied so far
+  double   latencySumMs = 0;   // event time -> frame that applied it
+  double   latencyMaxMs = 0;
+  Edge     edges[CAPACITY] = {};
+};
+
+// Web: the framebuffer lives in WASM memory; drawing never crosses into JS.
+// Present() expands the rows that changed into a persistent RGBA image, which
+// worker.js wraps once in an ImageData and puts to the canvas.
+struct Platform::Device::Impl {
+  static constexpr int FB_BYTES = Raster::BYTES;
+  uint8_t   fb[FB_BYTES] = {};      // SSD1306 page layout
+  uint8_t   shown[FB_BYTES] = {};   // fb as of the last Present(), for dirty rows
+  bool      shownValid = false;
+  uint8_t   dirty = 0;              // pages the draw calls changed since the last Present()
+  PresentStats presents;
+  Raster::Scroller scroll;          // the panel's hardware scroll, done by Present()
+  alignas(16) uint32_t rgba[Raster::WIDTH * Raster::HEIGHT] = {};  // RGBA8, row-major
+  InputRing input;
+  bool      buttons[2] = {false, false};  // sampled by PollInput()
+  uint32_t  rng = 0x9E3779B9u;      // xorshift32 state, seeded by Init()
+};
+
+namespace Platform {
+
+  inline bool Device::ButtonPressed(Button b) { return impl_->buttons[static_cast<int>(b)]; }
+  inline uint64_t Device::Millis()            { return static_cast<uint64_t>(js_now()); }
+
+  // Reduce speed scaling for smoother web gameplay
+  constexpr float Device::SpeedScale() { return 1.0f; }  // Reduced from 3.0f
+
+  inline int Device::RandomInt(int min_inclusive, int max_exclusive) {
+    return RandomRange(impl_->rng, min_inclusive, max_exclusive);
+  }
+  inline uint32_t Device::RandomState()          { return impl_->rng; }
+  inline void Device::SetRandomState(uint32_t s) { if (s) impl_->rng = s; }
+
+  inline void Device::ClearDisplay() { impl_->dirty |= Raster::Clear(impl_->fb); }
+  inline void Device::ScrollStart(int firstPage, int lastPage, bool right) {
+    impl_->scroll.Start(firstPage, lastPage, right, SCROLL_MS_PER_COLUMN, Millis());
+  }
+  inline void Device::ScrollStop() { impl_->scroll.Stop(); }
+  inline const PresentStats& Device::Presents() const { return impl_->presents; }
+
+  inline void Device::DrawPixel(int x, int y, bool on)                { impl_->dirty |= Raster::SetPixel(impl_->fb, x, y, on); }
+  inline void Device::DrawRect(int x, int y, int w, int h, bool on)   { impl_->dirty |= Raster::DrawRect(impl_->fb, x, y, w, h, on); }
+  inline void Device::FillRect(int x, int y, int w, int h, bool on)   { impl_->dirty |= Raster::FillRect(impl_->fb, x, y, w, h, on); }
+  inline void Device::DrawLine(int x0, int y0, int x1, int y1, bool on) { impl_->dirty |= Raster::DrawLine(impl_->fb, x0, y0, x1, y1, on); }
+  inline void Device::DrawSprite(int x, int y, const Raster::Sprite& s, Raster::Rop op) { impl_->dirty |= Raster::DrawSprite(impl_->fb, x, y, s, op); }
+  template <typename Layer> inline void Device::DrawLayer(Layer& l) { impl_->dirty |= l.Draw(impl_->fb); }
+  inline void Device::DrawText(int x, int y, const char* text, int scale, bool on) {
+    impl_->dirty |= Raster::DrawText(impl_->fb, x, y, text, scale, on);
+  }
+
+} // namespace Platform
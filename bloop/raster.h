@@ -0,0 +1,282 @@
+#pragma once
+#include "font5x7.h"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+// Header-only 1bpp rasterizer over a framebuffer in SSD1306 page layout:
+// byte (page * WIDTH + x) holds rows page*8 .. page*8+7 of column x, LSB on
+// top. Shared by every backend so primitives inline into the game code.
+//
+// The write paths return the pages whose bytes they changed (bit p for page
+// p, 0 if the call left the buffer as it was), so a backend can tell that a
+// frame differs from the last one it sent without keeping a copy of it.
+namespace Raster {
+  static constexpr int WIDTH  = 128;
+  static constexpr int HEIGHT = 64;
+  static constexpr int PAGES  = HEIGHT / 8;
+  static constexpr int BYTES  = WIDTH * PAGES;
+
+  // Pages holding any of the rows [y0, y1), clipped to the screen
+  inline uint8_t PageSpan(int y0, int y1) {
+    if (y0 < 0) y0 = 0;
+    if (y1 > HEIGHT) y1 = HEIGHT;
+    if (y0 >= y1) return 0;
+    unsigned first = static_cast<unsigned>(y0) >> 3, last = static_cast<unsigned>(y1 - 1) >> 3;
+    return static_cast<uint8_t>((0xFFu << first) & (0xFFu >> (PAGES - 1 - last)));
+  }
+
+  inline uint8_t Clear(uint8_t* fb) {
+    uint8_t changed = 0;
+    for (int page = 0; page < PAGES; ++page) {
+      uint8_t any = 0;
+      for (int x = 0; x < WIDTH; ++x) any |= fb[page * WIDTH + x];
+      if (any) changed |= static_cast<uint8_t>(1u << page);
+    }
+    std::memset(fb, 0, BYTES);
+    return changed;
+  }
+
+  // Shifts pages [first, last] by dx columns (positive: right) with one
+  // memmove per page; vacated columns wrap around or are cleared. Every
+  // shifted page counts as changed.
+  inline uint8_t ScrollPages(uint8_t* fb, int first, int last, int dx, bool wrap) {
+    if (first < 0) first = 0;
+    if (last >= PAGES) last = PAGES - 1;
+    dx %= WIDTH;
+    if (wrap && dx < 0) dx += WIDTH;
+    if (dx == 0 || first > last) return 0;
+    int n = dx < 0 ? -dx : dx;
+    uint8_t tmp[WIDTH];
+    uint8_t changed = 0;
+    for (int page = first; page <= last; ++page) {
+      changed |= static_cast<uint8_t>(1u << page);
+      uint8_t* row = fb + page * WIDTH;
+      if (dx > 0) {
+        if (wrap) std::memcpy(tmp, row + WIDTH - n, n);
+        std::memmove(row + n, row, WIDTH - n);
+        if (wrap) std::memcpy(row, tmp, n);
+        else      std::memset(row, 0, n);
+      } else {
+        std::memmove(row, row + n, WIDTH - n);
+        std::memset(row + WIDTH - n, 0, n);
+      }
+    }
+    return changed;
+  }
+
+  // Software stand-in for the SSD1306 continuous horizontal scroll: Apply()
+  // rotates the pages by the columns that came due since it last ran
+  struct Scroller {
+    bool     active = false;
+    bool     right = true;
+    uint8_t  first = 0, last = 0;
+    unsigned msPerColumn = 1;
+    uint64_t start = 0;
+    uint32_t applied = 0;   // columns already shifted
+
+    void Start(int firstPage, int lastPage, bool toRight, unsigned msPerCol, uint64_t now) {
+      active = true; right = toRight;
+      first = static_cast<uint8_t>(firstPage); last = static_cast<uint8_t>(lastPage);
+      msPerColumn = msPerCol ? msPerCol : 1;
+      start = now; applied = 0;
+    }
+    void Stop() { active = false; }
+
+    uint8_t Apply(uint8_t* fb, uint64_t now) {
+      if (!active) return 0;
+      uint32_t due = static_cast<uint32_t>((now - start) / msPerColumn);
+      if (due == applied) return 0;
+      int dx = static_cast<int>((due - applied) % WIDTH);
+      applied = due;
+      return ScrollPages(fb, first, last, right ? dx : -dx, true);
+    }
+  };
+
+  inline uint8_t SetPixel(uint8_t* fb, int x, int y, bool on) {
+    if (static_cast<unsigned>(x) >= WIDTH || static_cast<unsigned>(y) >= HEIGHT) return 0;
+    uint8_t bit = static_cast<uint8_t>(1u << (y & 7));
+    uint8_t& b = fb[(y >> 3) * WIDTH + x];
+    uint8_t was = b;
+    b = on ? (b | bit) : (b & static_cast<uint8_t>(~bit));
+    return b != was ? static_cast<uint8_t>(1u << (y >> 3)) : 0;
+  }
+
+  // Whole-byte column writes: one read-modify-write per page per column.
+  // A page changed if some column lacked (on) or had (off) a masked bit.
+  inline uint8_t FillRect(uint8_t* fb, int x, int y, int w, int h, bool on) {
+    int x0 = x < 0 ? 0 : x, x1 = x + w > WIDTH  ? WIDTH  : x + w;
+    int y0 = y < 0 ? 0 : y, y1 = y + h > HEIGHT ? HEIGHT : y + h;
+    if (x0 >= x1 || y0 >= y1) return 0;
+    uint8_t changed = 0;
+    for (int page = y0 >> 3; page <= (y1 - 1) >> 3; ++page) {
+      int top = page * 8;
+      int from = y0 > top ? y0 - top : 0;
+      int to   = y1 < top + 8 ? y1 - top : 8;
+      uint8_t mask = static_cast<uint8_t>((0xFFu << from) & (0xFFu >> (8 - to)));
+      uint8_t* row = fb + page * WIDTH;
+      uint8_t diff = 0;
+      if (on) for (int i = x0; i < x1; ++i) { diff |= static_cast<uint8_t>(~row[i]); row[i] |= mask; }
+      else    for (int i = x0; i < x1; ++i) { diff |= row[i]; row[i] &= static_cast<uint8_t>(~mask); }
+      if (diff & mask) changed |= static_cast<uint8_t>(1u << page);
+    }
+    return changed;
+  }
+
+  inline uint8_t DrawRect(uint8_t* fb, int x, int y, int w, int h, bool on) {
+    uint8_t changed = FillRect(fb, x, y, w, 1, on);
+    if (h > 1) changed |= FillRect(fb, x, y + h - 1, w, 1, on);
+    changed |= FillRect(fb, x, y, 1, h, on);
+    if (w > 1) changed |= FillRect(fb, x + w - 1, y, 1, h, on);
+    return changed;
+  }
+
+  inline uint8_t DrawLine(uint8_t* fb, int x0, int y0, int x1, int y1, bool on) {
+    int dx=std::abs(x1-x0), sx=x0<x1?1:-1;
+    int dy=-std::abs(y1-y0), sy=y0<y1?1:-1;
+    int err=dx+dy, e2;
+    uint8_t changed = 0;
+    while(true){
+      changed |= SetPixel(fb,x0,y0,on);
+      if(x0==x1&&y0==y1)break;
+      e2=2*err;
+      if(e2>=dy){ err+=dy; x0+=sx; }
+      if(e2<=dx){ err+=dx; y0+=sy; }
+    }
+    return changed;
+  }
+
+  // OR (or clear) one 8-row column byte at any y, split across two pages
+  inline uint8_t BlitColumn(uint8_t* fb, int x, int y, uint8_t bits, bool on) {
+    if (static_cast<unsigned>(x) >= WIDTH || y <= -8 || y >= HEIGHT || !bits) return 0;
+    int page = y >> 3;          // arithmetic shift: -1 for y in [-7, -1]
+    int shift = y & 7;
+    uint8_t lo = static_cast<uint8_t>(bits << shift);
+    uint8_t hi = static_cast<uint8_t>(shift ? bits >> (8 - shift) : 0);
+    uint8_t changed = 0;
+    if (page >= 0) {
+      uint8_t& b = fb[page * WIDTH + x];
+      uint8_t was = b;
+      b = on ? (b | lo) : (b & static_cast<uint8_t>(~lo));
+      if (b != was) changed |= static_cast<uint8_t>(1u << page);
+    }
+    if (hi && page + 1 < PAGES) {
+      uint8_t& b = fb[(page + 1) * WIDTH + x];
+      uint8_t was = b;
+      b = on ? (b | hi) : (b & static_cast<uint8_t>(~hi));
+      if (b != was) changed |= static_cast<uint8_t>(1u << (page + 1));
+    }
+    return changed;
+  }
+
+  // 1bpp image from the asset compiler (bloop/assets.h). For each vertical
+  // bit offset s in 0..7 the data holds pages + 1 page rows of w column bytes,
+  // already shifted down by s, so a sprite at any y is whole-byte ops. The
+  // mask (same layout) is the sprite's footprint; null means the ink itself.
+  struct Sprite {
+    uint8_t w, h, pages;
+    const uint8_t* data;
+    const uint8_t* mask;
+    int Offset(int s) const { return s * (pages + 1) * w; }
+  };
+
+  // Raster ops: OR sets the ink, AND_NOT clears the mask, XOR flips the ink
+  // (XOR twice at the same spot restores what was under it). AND_NOT then OR
+  // draws a sprite opaquely.
+  enum class Rop : uint8_t { OR, AND_NOT, XOR };
+
+  // One page row of a sprite into a page row of the framebuffer
+  inline void BlitRow(uint8_t* dst, const uint8_t* ink, const uint8_t* mask, int c0, int c1, Rop op) {
+    switch (op) {
+      case Rop::OR:      for (int c = c0; c < c1; ++c) dst[c] |= ink[c]; break;
+      case Rop::AND_NOT: for (int c = c0; c < c1; ++c) dst[c] &= static_cast<uint8_t>(~mask[c]); break;
+      case Rop::XOR:     for (int c = c0; c < c1; ++c) dst[c] ^= ink[c]; break;
+    }
+  }
+
+  // Clipped once up front, then whole bytes per column and page; the op is
+  // picked once per call. Takes framebuffer pages [p0, p1] and columns
+  // [x0, x1), both re-clamped here so the bounds are visible at the store;
+  // src is the sprite row for page p0, whose column 0 lands at x. Returns
+  // the changed pages, bit p for page p.
+  template <Rop OP>
+  inline uint8_t BlitPages(uint8_t* fb, const uint8_t* src, int stride, int p0, int p1, int x, int x0, int x1) {
+    if (p0 < 0) p0 = 0;
+    if (p1 > PAGES - 1) p1 = PAGES - 1;
+    if (x0 < 0) x0 = 0;
+    if (x1 > WIDTH) x1 = WIDTH;
+    uint8_t changed = 0;
+    for (int p = p0; p <= p1; ++p, src += stride) {
+      uint8_t* dst = fb + p * WIDTH;
+      uint8_t diff = 0;
+      for (int c = x0; c < x1; ++c) {
+        uint8_t b = src[c - x];
+        if (OP == Rop::OR)      { diff |= static_cast<uint8_t>(b & ~dst[c]); dst[c] |= b; }
+        if (OP == Rop::AND_NOT) { diff |= static_cast<uint8_t>(b & dst[c]);  dst[c] &= static_cast<uint8_t>(~b); }
+        if (OP == Rop::XOR)     { diff |= b;                                 dst[c] ^= b; }
+      }
+      if (diff) changed |= static_cast<uint8_t>(1u << p);
+    }
+    return changed;
+  }
+
+  inline uint8_t DrawSprite(uint8_t* fb, int x, int y, const Sprite& s, Rop op) {
+    int c0 = x < 0 ? -x : 0, c1 = x + s.w > WIDTH ? WIDTH - x : s.w;
+    if (c0 >= c1 || y <= -s.h || y >= HEIGHT) return 0;
+    int page = y >> 3;          // arithmetic shift, as in BlitColumn
+    int shift = y & 7;
+    int p0 = page < 0 ? 0 : page;
+    int p1 = (y + s.h - 1) >> 3;  // last page with ink: the spare row is empty at small shifts
+    const uint8_t* src = (op == Rop::AND_NOT && s.mask ? s.mask : s.data) + s.Offset(shift) + (p0 - page) * s.w;
+    switch (op) {
+      case Rop::OR:      return BlitPages<Rop::OR>(fb, src, s.w, p0, p1, x, x + c0, x + c1);
+      case Rop::AND_NOT: return BlitPages<Rop::AND_NOT>(fb, src, s.w, p0, p1, x, x + c0, x + c1);
+      case Rop::XOR:     return BlitPages<Rop::XOR>(fb, src, s.w, p0, p1, x, x + c0, x + c1);
+    }
+    return 0;
+  }
+
+  // Band versions for page renderers (display list, tile maps): the
+  // primitive restricted to rows [top, top+8), drawn into one WIDTH-byte page
+  inline void FillBand(uint8_t* page, int top, int x, int y, int w, int h, bool on) {
+    int y0 = y > top ? y : top, y1 = y + h < top + 8 ? y + h : top + 8;
+    if (y0 >= y1) return;
+    FillRect(page, x, y0 - top, w, y1 - y0, on);
+  }
+
+  // Only the pre-shifted sprite row that lands on this page
+  inline void SpriteBand(uint8_t* page, int top, int x, int y, const Sprite& s, Rop op) {
+    int p = (top >> 3) - (y >> 3);
+    int c0 = x < 0 ? -x : 0, c1 = x + s.w > WIDTH ? WIDTH - x : s.w;
+    if (p < 0 || p > s.pages || c0 >= c1) return;
+    int off = s.Offset(y & 7) + p * s.w;
+    BlitRow(page + x, s.data + off, (s.mask ? s.mask : s.data) + off, c0, c1, op);
+  }
+
+  // 5x7 text; scale 1 writes whole glyph columns, larger scales fill blocks
+  inline uint8_t DrawChar(uint8_t* fb, int x, int y, char c, int scale, bool on) {
+    if (c < 32 || c > 127) c = '?';
+    const uint8_t* g = ::FONT5x7[c - 32];
+    uint8_t changed = 0;
+    for (int col = 0; col < 5; ++col) {
+      uint8_t bits = g[col] & 0x7F;
+      if (scale == 1) { changed |= BlitColumn(fb, x + col, y, bits, on); continue; }
+      for (int row = 0; row < 7; ++row) {
+        if (bits & (1 << row)) changed |= FillRect(fb, x + col * scale, y + row * scale, scale, scale, on);
+      }
+    }
+    return changed;
+  }
+
+  inline uint8_t DrawText(uint8_t* fb, int x, int y, const char* t, int scale, bool on) {
+    if (scale <= 0) scale = 1;
+    int cx = x;
+    uint8_t changed = 0;
+    for (const char* p = t; *p; ++p) {
+      if (*p == '\n') { y += 8 * scale; cx = x; continue; }
+      changed |= DrawChar(fb, cx, y, *p, scale, on);
+      cx += 6 * scale;
+    }
+    return changed;
+  }
+}
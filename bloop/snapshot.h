@@ -0,0 +1,71 @@
+#pragma once
+#include <cstdint>
+
+// Suspend/resume snapshot: the running game, written when the player leaves
+// it and restored straight into play at the next boot. Little-endian bytes:
+//
+//   magic  u8   SNAPSHOT_MAGIC
+//   ver    u8   SNAPSHOT_VERSION; any other version is ignored
+//   game   u8   GameID
+//   len    u8   payload bytes
+//   payload     GameManager part (score, RNG state, menu position), then the
+//               game's own part (SnakeGame.cpp / Pong.cpp)
+//   sum    u16  Fletcher-16 of everything before it
+//
+// Only what cannot be rebuilt is stored: Snake keeps its head and a 2-bit
+// direction per body segment, not the world grid. Timers restart at the
+// resume, so none are stored.
+static constexpr uint8_t SNAPSHOT_MAGIC   = 0xB5;
+static constexpr uint8_t SNAPSHOT_VERSION = 1;
+static constexpr int     SNAPSHOT_HEADER  = 4;
+static constexpr int     SNAPSHOT_TRAILER = 2;
+
+// Bounds-checked byte cursor; a write that does not fit fails the writer
+class SnapWriter {
+public:
+  SnapWriter(uint8_t* buf, int cap) : buf_(buf), cap_(cap) {}
+
+  void U8(uint32_t v)  { if (n_ < cap_) buf_[n_++] = static_cast<uint8_t>(v); else ok_ = false; }
+  void U16(uint32_t v) { U8(v); U8(v >> 8); }
+  void U32(uint32_t v) { U16(v); U16(v >> 16); }
+  void I8(int v)       { U8(static_cast<uint8_t>(static_cast<int8_t>(v))); }
+
+  bool Ok() const   { return ok_; }
+  int  Size() const { return n_; }
+  uint8_t* Data()   { return buf_; }
+
+private:
+  uint8_t* buf_;
+  int      cap_;
+  int      n_ = 0;
+  bool     ok_ = true;
+};
+
+// Reading past the end yields zeros and fails the reader
+class SnapReader {
+public:
+  SnapReader(const uint8_t* buf, int n) : buf_(buf), n_(n) {}
+
+  uint32_t U8()  { if (pos_ < n_) return buf_[pos_++]; ok_ = false; return 0; }
+  uint32_t U16() { uint32_t lo = U8(); return lo | (U8() << 8); }
+  uint32_t U32() { uint32_t lo = U16(); return lo | (U16() << 16); }
+  int      I8()  { return static_cast<int8_t>(static_cast<uint8_t>(U8())); }
+
+  bool Ok() const   { return ok_; }
+  bool Done() const { return pos_ == n_; }
+
+private:
+  const uint8_t* buf_;
+  int  n_;
+  int  pos_ = 0;
+  bool ok_ = true;
+};
+
+inline uint16_t snapshotSum(const uint8_t* p, int n) {
+  uint32_t a = 0, b = 0;
+  for (int i = 0; i < n; ++i) {
+    a = (a + p[i]) % 255;
+    b = (b + a) % 255;
+  }
+  return static_cast<uint16_t>((b << 8) | a);
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+
+// SSD1306 command encoding, shared by the hardware backend and the host
+// panel model (host/panel_model.h) so both speak the same byte stream.
+namespace SSD1306 {
+
+  enum : uint8_t {
+    COLUMN_ADDR  = 0x21,   // + first, last column
+    PAGE_ADDR    = 0x22,   // + first, last page
+    SCROLL_RIGHT = 0x26,   // + 0, first page, interval, last page, 0, 0xFF
+    SCROLL_LEFT  = 0x27,
+    SCROLL_OFF   = 0x2E,
+    SCROLL_ON    = 0x2F,
+  };
+
+  // 128x64, internal charge pump, horizontal addressing; same setup as
+  // Adafruit_SSD1306::begin
+  static constexpr uint8_t INIT[] = {
+    0xAE, 0xD5, 0x80, 0xA8, 0x3F, 0xD3, 0x00, 0x40, 0x8D, 0x14, 0x20, 0x00,
+    0xA1, 0xC8, 0xDA, 0x12, 0x81, 0xCF, 0xD9, 0xF1, 0xDB, 0x40, 0xA4, 0xA6,
+    SCROLL_OFF, 0xAF
+  };
+
+  // Scroll step interval code 0b111: one column every 2 panel frames. With
+  // the 0xD5 0x80 clock the panel refreshes at ~100 Hz, so ~20 ms a column
+  // (Platform::SCROLL_MS_PER_COLUMN).
+  static constexpr uint8_t SCROLL_INTERVAL = 0x07;
+  static constexpr int     FRAME_MS = 10;
+  static constexpr int     INTERVAL_FRAMES[8] = { 5, 64, 128, 256, 3, 4, 25, 2 };
+
+  // Writes the horizontal scroll setup and activation for pages
+  // [first, last]; returns the byte count
+  inline int ScrollCommands(uint8_t* out, int first, int last, bool right) {
+    out[0] = right ? SCROLL_RIGHT : SCROLL_LEFT;
+    out[1] = 0x00;
+    out[2] = static_cast<uint8_t>(first);
+    out[3] = SCROLL_INTERVAL;
+    out[4] = static_cast<uint8_t>(last);
+    out[5] = 0x00;
+    out[6] = 0xFF;
+    out[7] = SCROLL_ON;
+    return 8;
+  }
+
+  // Address window for a write of pages [first, last], all columns
+  inline int Window(uint8_t* out, int first, int last) {
+    out[0] = PAGE_ADDR;   out[1] = static_cast<uint8_t>(first); out[2] = static_cast<uint8_t>(last);
+    out[3] = COLUMN_ADDR; out[4] = 0;                            out[5] = 127;
+    return 6;
+  }
+
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include <cstdint>
+
+#ifndef BLOOP_MAX_TASKS
+  #define BLOOP_MAX_TASKS 8
+#endif
+
+// Cooperative background work for everything that is not part of a frame:
+// storage commits, save serialisation, diagnostics. runGameLoop() calls
+// Run() after the frame is drawn with the frame's deadline, and due tasks
+// run in priority order while their cost still fits before it; the rest wait
+// for a later frame. A task that has waited until its latest time runs even
+// if it does not fit, so nothing is starved.
+//
+// A task is a plain function and an argument. It returns 0 when it is done,
+// or the delay in ms before it wants to run again (periodic work). Posting a
+// task that is already queued updates it instead of queueing it twice, so a
+// burst of writes ends in one commit.
+class TaskScheduler {
+public:
+  using Fn = uint32_t (*)(void* arg);
+
+  enum Priority : uint8_t { URGENT = 0, NORMAL = 1, IDLE = 2 };   // not HIGH/LOW: Arduino macros
+
+  static constexpr int      MAX_TASKS = BLOOP_MAX_TASKS;
+  static constexpr uint64_t NO_LIMIT  = ~0ull;
+
+  struct Stats {
+    uint32_t runs = 0;       // task invocations
+    uint32_t deferred = 0;   // frames that left a due task for later (no time)
+    uint32_t forced = 0;     // runs past the budget because the task was overdue
+    uint32_t dropped = 0;    // posts refused with the queue full
+    uint32_t maxCostMs = 0;  // slowest single run
+  };
+
+  // Queues fn(arg) to run no earlier than notBefore, and no later than
+  // latest whatever the budget. costMs is the expected run time; it is
+  // raised to the slowest run seen while the task stays queued.
+  bool Post(Fn fn, void* arg, Priority pri, uint32_t costMs,
+            uint64_t notBefore = 0, uint64_t latest = NO_LIMIT) {
+    Task* t = find(fn, arg);
+    if (!t) {
+      for (Task& s : tasks_) if (!s.fn) { t = &s; break; }
+      if (!t) { stats_.dropped++; return false; }
+      *t = Task{};
+      t->fn = fn;
+      t->arg = arg;
+    }
+    t->pri = pri;
+    if (costMs > t->costMs) t->costMs = costMs;
+    t->notBefore = notBefore;
+    t->latest = latest;
+    return true;
+  }
+
+  void Cancel(Fn fn, void* arg) {
+    if (Task* t = find(fn, arg)) t->fn = nullptr;
+  }
+
+  bool Pending(Fn fn, void* arg) const {
+    for (const Task& t : tasks_) if (t.fn == fn && t.arg == arg) return true;
+    return false;
+  }
+
+  // Runs due tasks, best priority (then earliest latest) first, while now +
+  // cost stays within deadline. clock() reads the live time in ms: the
+  // budget is what is actually left, not what the frame was given.
+  template <typename Clock>
+  int Run(uint64_t deadline, Clock clock) {
+    int ran = 0;
+    bool forcedOne = false;
+    for (;;) {
+      uint64_t now = clock();
+      Task* t = next(now);
+      if (!t) break;
+      bool fits = now + t->costMs <= deadline;
+      if (!fits) {
+        // At most one overdue task per frame goes over the budget
+        if (now < t->latest || forcedOne) { stats_.deferred++; break; }
+        forcedOne = true;
+        stats_.forced++;
+      }
+      Task run = *t;
+      t->fn = nullptr;                  // the task may post itself again
+      uint32_t again = run.fn(run.arg);
+      uint64_t end = clock();
+      uint32_t cost = static_cast<uint32_t>(end - now);
+      if (cost > stats_.maxCostMs) stats_.maxCostMs = cost;
+      stats_.runs++;
+      ran++;
+      if (again) Post(run.fn, run.arg, run.pri, cost > run.costMs ? cost : run.costMs, end + again);
+    }
+    return ran;
+  }
+
+  const Stats& GetStats() const { return stats_; }
+
+private:
+  struct Task {
+    Fn       fn = nullptr;
+    void*    arg = nullptr;
+    Priority pri = NORMAL;
+    uint32_t costMs = 0;
+    uint64_t notBefore = 0;
+    uint64_t latest = NO_LIMIT;
+  };
+
+  Task* find(Fn fn, void* arg) {
+    for (Task& t : tasks_) if (t.fn == fn && t.arg == arg) return &t;
+    return nullptr;
+  }
+
+  Task* next(uint64_t now) {
+    Task* best = nullptr;
+    for (Task& t : tasks_) {
+      if (!t.fn || now < t.notBefore) continue;
+      if (!best || t.pri < best->pri || (t.pri == best->pri && t.latest < best->latest)) best = &t;
+    }
+    return best;
+  }
+
+  Task  tasks_[MAX_TASKS];
+  Stats stats_;
+};
@@ -0,0 +1,111 @@
+#pragma once
+#include "cell_grid.h"
+#include "raster.h"
+
+// Tile-map layer for grid games: a COLS x ROWS grid of tile indices packed
+// BITS to a cell, drawn with a tile set of equal-size sprites (a sheet from
+// bloop/assets.h; index 0 is the empty tile and is never blitted). Set()
+// marks a cell dirty only when its index changes, and Draw() re-rasterizes
+// just the dirty cells, so a frame costs what changed rather than the map.
+//
+// Tiles are opaque: the layer owns its rectangle. Anything drawn over it
+// (overlays, clears) is not tracked, so call Invalidate() afterwards and the
+// next draw repaints every cell. Plain data, safe to copy with its owner.
+namespace Raster {
+
+  template <int COLS, int ROWS, int BITS = 2>
+  class TileMap {
+  public:
+    static constexpr int CELLS = COLS * ROWS;
+    static constexpr int KINDS = 1 << BITS;
+
+    // Tile set and top-left corner on screen; the map starts empty and dirty
+    void Init(const Sprite* tiles, int x, int y) {
+      tiles_ = tiles;
+      x_ = x; y_ = y;
+      Fill(0);
+      Invalidate();
+    }
+
+    uint8_t Get(int col, int row) const { return cells_.Get(col, row); }
+
+    void Set(int col, int row, uint8_t tile) {
+      int i = row * COLS + col;
+      if (cells_.At(i) == tile) return;
+      cells_.Put(i, tile);
+      dirty_[i >> 5] |= 1u << (i & 31);
+    }
+
+    // Every cell to one tile, without marking anything dirty
+    void Fill(uint8_t tile) { cells_.Fill(tile); }
+
+    void Invalidate() { std::memset(dirty_, 0xFF, sizeof(dirty_)); }
+
+    // Screen pages holding a dirty cell: what a page renderer has to resend
+    uint8_t DirtyPages() const {
+      const int th = tiles_[0].h;
+      uint8_t pages = 0;
+      for (int w = 0; w < WORDS; ++w) {
+        for (uint32_t bits = dirty_[w]; bits; bits &= bits - 1) {
+          int i = w * 32 + __builtin_ctz(bits);
+          if (i >= CELLS) break;
+          int top = y_ + (i / COLS) * th;
+          pages |= PageSpan(top, top + th);
+        }
+      }
+      return pages;
+    }
+    void ClearDirty() { std::memset(dirty_, 0, sizeof(dirty_)); }
+
+    int X() const      { return x_; }
+    int Y() const      { return y_; }
+    int Width() const  { return COLS * tiles_[0].w; }
+    int Height() const { return ROWS * tiles_[0].h; }
+
+    // Framebuffer backends: repaint the dirty cells, then forget them.
+    // Returns the framebuffer pages that changed, as the Raster writes do.
+    uint8_t Draw(uint8_t* fb) {
+      const int tw = tiles_[0].w, th = tiles_[0].h;
+      uint8_t changed = 0;
+      for (int w = 0; w < WORDS; ++w) {
+        uint32_t bits = dirty_[w];
+        dirty_[w] = 0;
+        while (bits) {
+          int i = w * 32 + __builtin_ctz(bits);
+          bits &= bits - 1;
+          if (i >= CELLS) break;
+          int cx = x_ + (i % COLS) * tw, cy = y_ + (i / COLS) * th;
+          changed |= FillRect(fb, cx, cy, tw, th, false);
+          if (uint8_t t = cells_.At(i)) changed |= DrawSprite(fb, cx, cy, tiles_[t], Rop::OR);
+        }
+      }
+      return changed;
+    }
+
+    // Page renderer (DisplayList::DrawLayer): the cell rows overlapping
+    // rows [top, top+8), into one WIDTH-byte page
+    static void Band(const void* self, uint8_t* page, int top) {
+      const TileMap& m = *static_cast<const TileMap*>(self);
+      const int tw = m.tiles_[0].w, th = m.tiles_[0].h;
+      if (top + 8 <= m.y_ || top >= m.y_ + ROWS * th) return;
+      FillBand(page, top, m.x_, m.y_, COLS * tw, ROWS * th, false);
+      int r0 = top > m.y_ ? (top - m.y_) / th : 0;
+      int r1 = (top + 8 - m.y_ + th - 1) / th;
+      if (r1 > ROWS) r1 = ROWS;
+      for (int r = r0; r < r1; ++r) {
+        for (int c = 0; c < COLS; ++c) {
+          if (uint8_t t = m.cells_.At(r * COLS + c)) SpriteBand(page, top, m.x_ + c * tw, m.y_ + r * th, m.tiles_[t], Rop::OR);
+        }
+      }
+    }
+
+  private:
+    static constexpr int WORDS = (CELLS + 31) / 32;
+
+    CellGrid<COLS, ROWS, BITS> cells_;
+    uint32_t dirty_[WORDS] = {};
+    const Sprite* tiles_ = nullptr;
+    int      x_ = 0, y_ = 0;
+  };
+
+}
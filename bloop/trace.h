@@ -0,0 +1,138 @@
+#pragma once
+#include <cstdint>
+
+// Scoped hot-path timers, exported as Chrome trace-event JSON (open the file
+// in Perfetto or chrome://tracing). Build with -DBLOOP_TRACE=1 to record;
+// otherwise BLOOP_TRACE_SCOPE expands to nothing and costs nothing.
+//
+//   void stepSnake(...) { BLOOP_TRACE_SCOPE("stepSnake"); ... }
+//
+// Each scope writes one complete event (name, start, duration) into a fixed
+// ring of the last BLOOP_TRACE_EVENTS, overwriting the oldest. The clock is
+// the cheapest precise one per target: the RISC-V cycle counter on the
+// ESP32-C3, performance.now() on web, steady_clock on host. Names must be
+// string literals. The host keeps one ring per thread, so sessions running
+// side by side do not mix.
+
+#ifndef BLOOP_TRACE
+  #define BLOOP_TRACE 0
+#endif
+
+#if BLOOP_TRACE
+
+#ifndef BLOOP_TRACE_EVENTS
+  #define BLOOP_TRACE_EVENTS 512
+#endif
+#ifndef BLOOP_CPU_MHZ
+  #define BLOOP_CPU_MHZ 160       // ESP32-C3 default clock, for cycles -> us
+#endif
+
+#include <cstdio>
+#include <cstring>
+#if defined(ARDUINO)
+  #include <esp_cpu.h>
+#elif defined(__EMSCRIPTEN__)
+  #include <emscripten.h>
+#else
+  #include <chrono>
+#endif
+
+namespace Trace {
+
+#if defined(ARDUINO)
+  static constexpr double TICKS_PER_US = BLOOP_CPU_MHZ;
+  // The cycle counter is 32 bits (27 s at 160 MHz); widened on read, which
+  // happens every frame while tracing
+  inline uint64_t Now() {
+    static uint32_t last = 0, high = 0;
+    uint32_t c = static_cast<uint32_t>(esp_cpu_get_cycle_count());
+    if (c < last) high++;
+    last = c;
+    return (static_cast<uint64_t>(high) << 32) | c;
+  }
+  #define BLOOP_TRACE_LOCAL
+#elif defined(__EMSCRIPTEN__)
+  static constexpr double TICKS_PER_US = 1.0;
+  inline uint64_t Now() { return static_cast<uint64_t>(emscripten_get_now() * 1000.0); }
+  #define BLOOP_TRACE_LOCAL
+#else
+  static constexpr double TICKS_PER_US = 1000.0;
+  inline uint64_t Now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+  }
+  #define BLOOP_TRACE_LOCAL thread_local
+#endif
+
+  struct Event {
+    const char* name;
+    uint64_t    start;   // ticks
+    uint32_t    dur;     // ticks
+  };
+
+  struct Ring {
+    static constexpr uint32_t SIZE = BLOOP_TRACE_EVENTS;
+    Event    ev[SIZE];
+    uint32_t head = 0;   // events recorded, ever
+
+    uint32_t Count() const { return head < SIZE ? head : SIZE; }
+    const Event& Oldest(uint32_t i) const { return ev[(head - Count() + i) % SIZE]; }
+  };
+
+  inline Ring& ring() {
+    static BLOOP_TRACE_LOCAL Ring r;
+    return r;
+  }
+
+  inline void Record(const char* name, uint64_t start, uint64_t end) {
+    Ring& r = ring();
+    r.ev[r.head++ % Ring::SIZE] = Event{name, start, static_cast<uint32_t>(end - start)};
+  }
+
+  class Scope {
+  public:
+    explicit Scope(const char* name) : name_(name), start_(Now()) {}
+    ~Scope() { Record(name_, start_, Now()); }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+  private:
+    const char* name_;
+    uint64_t    start_;
+  };
+
+  inline void Clear() { ring().head = 0; }
+
+  // Writes the ring, oldest first, as a trace-event JSON document through
+  // write(text, n, user) in chunks of at most one event. Times are us from
+  // the oldest event.
+  using Sink = void (*)(const char* text, int n, void* user);
+  inline void WriteJson(Sink write, void* user) {
+    const Ring& r = ring();
+    const uint32_t n = r.Count();
+    uint64_t t0 = ~0ull;   // events are stored as they end; parents start first
+    for (uint32_t i = 0; i < n; ++i) if (r.Oldest(i).start < t0) t0 = r.Oldest(i).start;
+    char buf[160];
+    const char* head = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    write(head, static_cast<int>(std::strlen(head)), user);
+    for (uint32_t i = 0; i < n; ++i) {
+      const Event& e = r.Oldest(i);
+      int len = std::snprintf(buf, sizeof(buf),
+                              "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}\n",
+                              i ? "," : "", e.name, (e.start - t0) / TICKS_PER_US, e.dur / TICKS_PER_US);
+      if (len > static_cast<int>(sizeof(buf)) - 1) len = sizeof(buf) - 1;
+      write(buf, len, user);
+    }
+    write("]}\n", 3, user);
+  }
+
+}
+
+#define BLOOP_TRACE_CAT2(a, b) a##b
+#define BLOOP_TRACE_CAT(a, b) BLOOP_TRACE_CAT2(a, b)
+#define BLOOP_TRACE_SCOPE(name) ::Trace::Scope BLOOP_TRACE_CAT(bloopTrace_, __LINE__)(name)
+
+#else
+
+#define BLOOP_TRACE_SCOPE(name) ((void)0)
+
+#endif
@@ -0,0 +1,122 @@
+#include "agent.h"
+
+namespace {
+
+  // Turns towards the food; presses are single-frame so every one is an edge
+  class SnakeGreedyAgent : public Agent {
+  public:
+    InputState act(const Observation& obs) override {
+      InputState in;
+      if (pressedLast_) { pressedLast_ = false; return in; }
+
+      if (obs.bigSnake) steer(*obs.bigSnake, in);
+      else steer(*obs.snake, in);
+      pressedLast_ = in.buttonA || in.buttonB;
+      return in;
+    }
+  private:
+    template <class S>
+    static void steer(const S& s, InputState& in) {
+      const SnakeRules::Pt head = s.Head();
+      int want = s.dir;
+      if      (s.food.x > head.x) want = SnakeState::RIGHT;
+      else if (s.food.x < head.x) want = SnakeState::LEFT;
+      else if (s.food.y > head.y) want = SnakeState::DOWN;
+      else if (s.food.y < head.y) want = SnakeState::UP;
+
+      int turn = (want - s.dir + 4) % 4;   // 1 = clockwise, 3 = counter-clockwise
+      if (turn == 1 || turn == 2) in.buttonB = true;
+      else if (turn == 3)         in.buttonA = true;
+    }
+
+    bool pressedLast_ = false;
+  };
+
+  // Keeps the paddle centre on where the ball was a human reaction time ago,
+  // aiming at a random spot each rally so that it misses now and then
+  class PongTrackingAgent : public Agent {
+  public:
+    explicit PongTrackingAgent(uint32_t seed) : rng_(seed | 1u) {}
+
+    InputState act(const Observation& obs) override {
+      const PongState& p = *obs.pong;
+      if (p.ball.vx != lastVX_) {
+        lastVX_ = p.ball.vx;
+        rng_ ^= rng_ << 13; rng_ ^= rng_ >> 17; rng_ ^= rng_ << 5;
+        aim_ = static_cast<int>(rng_ % (2 * MAX_AIM + 1)) - MAX_AIM;
+      }
+      seen_[head_] = p.ball.y;
+      head_ = (head_ + 1) % REACTION_FRAMES;
+      if (filled_ < REACTION_FRAMES) filled_++;
+      int ballY = filled_ < REACTION_FRAMES ? p.ball.y : seen_[head_];
+
+      int bc = ballY + PongState::BALL_SIZE / 2;
+      int pc = p.player.y + PongState::PADDLE_HEIGHT / 2 + aim_;
+      InputState in;
+      in.buttonA = bc < pc - 1;
+      in.buttonB = bc > pc + 1;
+      // Nudge the paddle once so the ball gets served
+      if (!p.gameActive) in.buttonB = true;
+      return in;
+    }
+  private:
+    static constexpr int REACTION_FRAMES = 12;   // ~200 ms at 60 fps
+    static constexpr int MAX_AIM = 5;            // px off the paddle centre
+    int seen_[REACTION_FRAMES] = {};
+    int head_ = 0;
+    int filled_ = 0;
+    uint32_t rng_;
+    int lastVX_ = 0;
+    int aim_ = 0;
+  };
+
+} // anon
+
+std::unique_ptr<Agent> makeBaselineAgent(GameID game, uint32_t seed) {
+  if (game != GameID::PONG) return std::unique_ptr<Agent>(new SnakeGreedyAgent());
+  return std::unique_ptr<Agent>(new PongTrackingAgent(seed));
+}
+
+EpisodeResult runEpisode(GameID game, const TuningParams& params, Agent& agent,
+                         uint32_t seed, long maxFrames) {
+  Platform::Device::Impl impl;
+  impl.rng = seed | 1u;
+  Platform::Device dev(&impl);
+  std::unique_ptr<GameContext> ctx(new GameContext(dev));
+  dev.Init();
+  initGameManager(*ctx);
+
+  if (game == GameID::SNAKE) {
+    ctx->games.Emplace<SnakeState>().moveDelayMs = params.snakeMoveDelayMs;
+  } else if (game == GameID::BIG_SNAKE) {
+    ctx->games.Emplace<BigSnakeState>().moveDelayMs = params.snakeMoveDelayMs;
+  } else {
+    PongState& p = ctx->games.Emplace<PongState>();
+    p.paddleSpeed = params.pongPaddleSpeed;
+    p.tickMs      = params.pongTickMs;
+  }
+
+  // Straight into the game, as if picked from the menu (skipping the boot flow)
+  ctx->sys = Flow();
+  ctx->activeGame = game;
+  ctx->gameInited = false;
+  ctx->state = SysState::IN_GAME;
+
+  EpisodeResult r;
+  for (; r.frames < maxFrames; ++r.frames) {
+    Observation obs{game, ctx->games.Get<SnakeState>(), ctx->games.Get<BigSnakeState>(), ctx->games.Get<PongState>(),
+                    impl.fb, impl.now, ctx->currentScore};
+    InputState in = agent.act(obs);
+    impl.buttons[0] = in.buttonA;
+    impl.buttons[1] = in.buttonB;
+
+    runGameLoop(*ctx);
+    if (ctx->state != SysState::IN_GAME) {
+      r.score = ctx->state == SysState::GAME_OVER ? ctx->gameOverScore : ctx->currentScore;
+      return r;
+    }
+  }
+  r.score = ctx->currentScore;
+  r.timedOut = true;
+  return r;
+}
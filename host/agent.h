@@ -0,0 +1,45 @@
+#pragma once
+#include "GameManager.h"
+#include "platform_host.h"
+#include <memory>
+
+// What an agent sees each tick: the live game state plus the raw 1bpp
+// framebuffer (SSD1306 page layout), for agents that learn from pixels.
+struct Observation {
+  GameID           game;
+  const SnakeState*    snake;     // valid when game == SNAKE
+  const BigSnakeState* bigSnake;  // valid when game == BIG_SNAKE
+  const PongState*     pong;      // valid when game == PONG
+  const uint8_t*    framebuffer;  // Platform::Device::Impl::FB_BYTES bytes
+  uint64_t          now;          // session clock in ms
+  int               score;
+};
+
+// A player. One instance per episode, so agents may keep private state.
+class Agent {
+public:
+  virtual ~Agent() = default;
+  virtual InputState act(const Observation& obs) = 0;
+};
+
+using AgentFactory = std::unique_ptr<Agent> (*)(GameID game, uint32_t seed);
+
+// Built-in baseline players (greedy snake, ball-tracking pong)
+std::unique_ptr<Agent> makeBaselineAgent(GameID game, uint32_t seed);
+
+// Difficulty knobs swept by tuning runs
+struct TuningParams {
+  unsigned snakeMoveDelayMs = SnakeState::MOVE_DELAY_MS_BASE;
+  int      pongPaddleSpeed  = PongState::PADDLE_SPEED_BASE;
+  unsigned pongTickMs       = PongState::TICK_MS_BASE;
+};
+
+struct EpisodeResult {
+  int  score  = 0;
+  long frames = 0;
+  bool timedOut = false;
+};
+
+// Plays one game from its Get Ready screen to game over (or maxFrames)
+EpisodeResult runEpisode(GameID game, const TuningParams& params, Agent& agent,
+                         uint32_t seed, long maxFrames);
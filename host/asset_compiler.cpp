@@ -0,0 +1,216 @@
+// Build-time asset compiler: converts 1bpp PBM images (P1 or P4) into
+// constexpr Raster::Sprite tables in SSD1306 page order, with a pre-shifted
+// copy for each of the 8 vertical bit offsets (layout in bloop/raster.h).
+// A "# frame <w>" comment marks a sprite sheet: the image is cut into frames
+// <w> columns wide and emitted as an array. <name>.mask.pbm, when given, is
+// the footprint of <name>.pbm (cleared by Rop::AND_NOT). Inputs are sorted and nothing
+// time- or path-dependent is written, so the output is reproducible.
+//
+//   asset_compiler -o <header> <image.pbm>...
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+  struct Image {
+    std::string name;       // C identifier, from the file name
+    std::string file;       // base name, for the comment
+    int w = 0, h = 0;
+    int frameW = 0;         // 0: a single sprite
+    bool isMask = false;    // <name>.mask.pbm
+    std::vector<uint8_t> px; // row-major, 1 = ink
+  };
+
+  bool fail(const std::string& file, const char* what) {
+    std::fprintf(stderr, "asset_compiler: %s: %s\n", file.c_str(), what);
+    return false;
+  }
+
+  // Header token, collecting "# frame <w>" from comments on the way
+  bool token(std::istream& in, std::string& tok, int& frameW) {
+    tok.clear();
+    int c;
+    while ((c = in.get()) != EOF) {
+      if (c == '#') {
+        std::string line;
+        std::getline(in, line);
+        std::istringstream cs(line);
+        std::string key;
+        if (cs >> key && key == "frame") cs >> frameW;
+        continue;
+      }
+      if (std::isspace(c)) { if (!tok.empty()) return true; continue; }
+      tok += static_cast<char>(c);
+    }
+    return !tok.empty();
+  }
+
+  bool load(const std::string& path, Image& img) {
+    std::ifstream in(path, std::ios::binary);
+    size_t slash = path.find_last_of('/');
+    img.file = slash == std::string::npos ? path : path.substr(slash + 1);
+    if (!in) return fail(img.file, "cannot open");
+
+    std::string magic, ws, hs;
+    if (!token(in, magic, img.frameW) || (magic != "P1" && magic != "P4")) return fail(img.file, "not a PBM (P1/P4)");
+    if (!token(in, ws, img.frameW) || !token(in, hs, img.frameW)) return fail(img.file, "truncated header");
+    img.w = std::atoi(ws.c_str());
+    img.h = std::atoi(hs.c_str());
+    if (img.w <= 0 || img.w > 128 || img.h <= 0 || img.h > 64) return fail(img.file, "size must be within 128x64");
+    if (img.frameW && (img.frameW < 0 || img.w % img.frameW)) return fail(img.file, "width is not a multiple of the frame width");
+
+    img.px.assign(static_cast<size_t>(img.w) * img.h, 0);
+    if (magic == "P1") {
+      for (auto& p : img.px) {
+        int c;
+        do c = in.get(); while (c != EOF && c != '0' && c != '1');
+        if (c == EOF) return fail(img.file, "truncated pixel data");
+        p = c == '1';
+      }
+    } else {
+      int stride = (img.w + 7) / 8;
+      std::vector<uint8_t> row(stride);
+      for (int y = 0; y < img.h; ++y) {
+        if (!in.read(reinterpret_cast<char*>(row.data()), stride)) return fail(img.file, "truncated pixel data");
+        for (int x = 0; x < img.w; ++x) img.px[y * img.w + x] = (row[x >> 3] >> (7 - (x & 7))) & 1;
+      }
+    }
+
+    img.isMask = img.file.find(".mask.") != std::string::npos;
+    std::string base = img.file.substr(0, img.file.find('.'));
+    for (char c : base) img.name += std::isalnum(static_cast<unsigned char>(c)) ? static_cast<char>(std::toupper(c)) : '_';
+    if (img.name.empty() || std::isdigit(static_cast<unsigned char>(img.name[0]))) img.name = "A_" + img.name;
+    return true;
+  }
+
+  // One frame, all 8 shifts: [shift][page 0..pages][column]
+  void pack(const Image& img, int x0, int w, std::vector<uint8_t>& out) {
+    int pages = (img.h + 7) / 8;
+    for (int s = 0; s < 8; ++s) {
+      for (int p = 0; p <= pages; ++p) {
+        for (int x = 0; x < w; ++x) {
+          uint8_t b = 0;
+          for (int bit = 0; bit < 8; ++bit) {
+            int y = p * 8 + bit - s;
+            if (y >= 0 && y < img.h && img.px[y * img.w + x0 + x]) b |= static_cast<uint8_t>(1u << bit);
+          }
+          out.push_back(b);
+        }
+      }
+    }
+  }
+
+  std::vector<uint8_t> packAll(const Image& img, int frames, int fw) {
+    std::vector<uint8_t> data;
+    for (int f = 0; f < frames; ++f) pack(img, f * fw, fw, data);
+    return data;
+  }
+
+  void table(std::ostringstream& o, const std::string& name, const std::vector<uint8_t>& data) {
+    o << "  static constexpr uint8_t " << name << "[] = {";
+    for (size_t i = 0; i < data.size(); ++i) {
+      if (i % 16 == 0) o << "\n    ";
+      char hex[8];
+      std::snprintf(hex, sizeof(hex), "0x%02X,", data[i]);
+      o << hex << ((i + 1) % 16 && i + 1 < data.size() ? " " : "");
+    }
+    o << "\n  };\n";
+  }
+
+  void emit(std::ostringstream& o, const Image& img, const Image* mask) {
+    int frames = img.frameW ? img.w / img.frameW : 1;
+    int fw = img.frameW ? img.frameW : img.w;
+    int pages = (img.h + 7) / 8;
+    std::vector<uint8_t> data = packAll(img, frames, fw);
+    std::vector<uint8_t> maskData = mask ? packAll(*mask, frames, fw) : std::vector<uint8_t>();
+    size_t perFrame = data.size() / frames;
+    size_t total = data.size() + maskData.size();
+
+    o << "\n  // " << img.file << ": " << fw << "x" << img.h;
+    if (frames > 1) o << ", " << frames << " frames";
+    if (mask) o << ", masked";
+    o << ", " << total << " B\n";
+    table(o, img.name + "_DATA", data);
+    if (mask) table(o, img.name + "_MASK", maskData);
+    auto init = [&](int f) {
+      std::string off = f ? " + " + std::to_string(f * perFrame) : "";
+      o << "{ " << fw << ", " << img.h << ", " << pages << ", " << img.name << "_DATA" << off << ", "
+        << (mask ? img.name + "_MASK" + off : std::string("nullptr")) << " }";
+    };
+    if (frames == 1) {
+      o << "  static constexpr Raster::Sprite " << img.name << " = ";
+      init(0);
+      o << ";\n";
+    } else {
+      o << "  static constexpr Raster::Sprite " << img.name << "[" << frames << "] = {\n";
+      for (int f = 0; f < frames; ++f) { o << "    "; init(f); o << ",\n"; }
+      o << "  };\n";
+    }
+
+    size_t plain = static_cast<size_t>(fw) * pages * frames * (mask ? 2 : 1);
+    std::printf("%-16s %3dx%-3d %2d frame%s %s packed %5zu B  with shifts %6zu B\n",
+                img.file.c_str(), fw, img.h, frames, frames > 1 ? "s" : " ", mask ? "+mask" : "     ", plain, total);
+  }
+
+} // anon
+
+int main(int argc, char** argv) {
+  std::string outPath;
+  std::vector<std::string> inputs;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc) outPath = argv[++i];
+    else inputs.push_back(argv[i]);
+  }
+  if (outPath.empty() || inputs.empty()) {
+    std::fprintf(stderr, "usage: asset_compiler -o <header> <image.pbm>...\n");
+    return 2;
+  }
+
+  std::vector<Image> images(inputs.size());
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    if (!load(inputs[i], images[i])) return 1;
+  }
+  std::sort(images.begin(), images.end(), [](const Image& a, const Image& b) {
+    return a.name != b.name ? a.name < b.name : a.isMask < b.isMask;
+  });
+  for (size_t i = 1; i < images.size(); ++i) {
+    if (images[i].name == images[i - 1].name && images[i].isMask == images[i - 1].isMask) {
+      fail(images[i].file, "duplicate asset name");
+      return 1;
+    }
+  }
+
+  std::ostringstream o;
+  o << "#pragma once\n"
+       "#include \"raster.h\"\n\n"
+       "// Generated by host/asset_compiler from assets/*.pbm; do not edit.\n"
+       "// Rebuild with `make -C host assets`.\n"
+       "namespace Assets {\n";
+  for (size_t i = 0; i < images.size(); ++i) {
+    const Image& img = images[i];
+    if (img.isMask) {
+      if (i == 0 || images[i - 1].name != img.name) { fail(img.file, "mask without an image"); return 1; }
+      continue;
+    }
+    const Image* mask = i + 1 < images.size() && images[i + 1].name == img.name ? &images[i + 1] : nullptr;
+    if (mask && (mask->w != img.w || mask->h != img.h || mask->frameW != img.frameW)) {
+      fail(mask->file, "mask size differs from the image");
+      return 1;
+    }
+    emit(o, img, mask);
+  }
+  o << "\n}\n";
+
+  std::ofstream out(outPath, std::ios::binary);
+  out << o.str();
+  if (!out) { fail(outPath, "cannot write"); return 1; }
+  return 0;
+}
@@ -0,0 +1,64 @@
+// Render-path cost per frame through Platform::Device: the Snake and Pong
+// draw sequences repeated on the default device. Builds natively
+// (host/Makefile) and for WASM (web/Makefile bench, run under Node), so
+// per-primitive call overhead shows up on both.
+//
+//   frame_bench [frames]
+
+#include "GameManager.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace Platform;
+
+namespace {
+
+  void snakeFrame(GameContext& ctx, int f) {
+    Device& dev = ctx.dev;
+    clearPlayfield(ctx);
+    drawStatusBar(ctx, "SNAKE", 17, 42);
+    for (int i = 0; i < 20; ++i) {
+      int x = (f + i) % 32, y = (i * 3) % 12;
+      dev.FillRect(x * 4, y * 4 + STATUS_BAR_HEIGHT, 4, 4, true);
+    }
+    dev.FillRect((f * 7) % 32 * 4, STATUS_BAR_HEIGHT + 20, 4, 4, true);
+    dev.Present();
+  }
+
+  void pongFrame(GameContext& ctx, int f) {
+    Device& dev = ctx.dev;
+    clearPlayfield(ctx);
+    drawStatusBar(ctx, "PONG", 5, 12);
+    for (int x = 0; x < SCREEN_WIDTH; x += 4) {
+      dev.DrawPixel(x, STATUS_BAR_HEIGHT, true);   dev.DrawPixel(x + 1, STATUS_BAR_HEIGHT, true);
+      dev.DrawPixel(x, SCREEN_HEIGHT - 1, true);   dev.DrawPixel(x + 1, SCREEN_HEIGHT - 1, true);
+    }
+    for (int y = STATUS_BAR_HEIGHT; y < SCREEN_HEIGHT; y += 4) {
+      dev.DrawPixel(0, y, true); dev.DrawPixel(SCREEN_WIDTH - 1, y, true);
+      dev.DrawPixel(SCREEN_WIDTH / 2, y, true);
+    }
+    int y = STATUS_BAR_HEIGHT + (f % (PLAYFIELD_HEIGHT - 10));
+    dev.FillRect(3, y, 2, 10, true);
+    dev.FillRect(SCREEN_WIDTH - 5, y, 2, 10, true);
+    dev.FillRect(f % SCREEN_WIDTH, y + 4, 2, 2, true);
+    dev.Present();
+  }
+
+  template <typename F>
+  double nsPerFrame(GameContext& ctx, int frames, F frame) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; ++f) frame(ctx, f);
+    auto dt = std::chrono::steady_clock::now() - t0;
+    return std::chrono::duration<double, std::nano>(dt).count() / frames;
+  }
+
+} // anon
+
+int main(int argc, char** argv) {
+  int frames = argc > 1 ? std::atoi(argv[1]) : 20000;
+  GameContext ctx(Default());
+  std::printf("snake frame  %8.0f ns\n", nsPerFrame(ctx, frames, snakeFrame));
+  std::printf("pong frame   %8.0f ns\n", nsPerFrame(ctx, frames, pongFrame));
+  return 0;
+}
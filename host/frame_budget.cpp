@@ -0,0 +1,272 @@
+// Cycle-budget gate. It replays a fixed corpus of sessions: boot and menus
+// on scripted input, then Snake, Big Snake and Pong played by the baseline
+// agents. It counts the work each runGameLoop() does and turns the counts
+// into predicted ESP32-C3 frame times. It fails when a predicted frame
+// exceeds the 16 ms budget, or, given a baseline, when a frame or a whole
+// corpus entry costs more than --max-regress percent over the baseline. A
+// --baseline that cannot be read, or was counted by another compiler, is an
+// error: the regression half of the gate must never be skipped quietly.
+//
+// The count is of basic blocks executed, from compiler instrumentation
+// (-fsanitize-coverage=trace-pc, see the Makefile): every block calls
+// __sanitizer_cov_trace_pc() below. It needs no PMU and is exact, so the
+// same tree and compiler give the same counts on any machine, and any
+// regression fails the run. Counts from another compiler are not compared.
+//
+// Only CPU work is modelled. The I2C transfer in Present() depends on the
+// bus clock and bytes sent (scroll_check reports those), not on the code.
+//
+//   bloop_budget [--baseline FILE] [--write-baseline FILE] [--max-regress PCT]
+//                [--cycles-per-block X]
+
+#include "agent.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Blocks executed so far. Read through a volatile: the compiler treats the
+// hook as a leaf that cannot touch this file's globals.
+uint64_t gBlocks = 0;
+extern "C" __attribute__((no_sanitize_coverage)) void __sanitizer_cov_trace_pc() { ++gBlocks; }
+
+namespace {
+
+  // The device model. ESP_CYCLES_PER_BLOCK is an assumption, not a
+  // measurement: about 5 instructions per block at about 2 cycles each for
+  // RV32IMC running from the flash cache. Until it is calibrated, read the
+  // predicted milliseconds as an order of magnitude; the regression check
+  // compares block counts and does not depend on it. To calibrate, run
+  // bloop_trace's corpus with BLOOP_TRACE=1 on the device and divide its
+  // runGameLoop cycles (minus Present's bus time) by these block counts for
+  // the same frames, then pass the result to --cycles-per-block.
+  constexpr double ESP_MHZ              = 160.0;
+  constexpr double ESP_CYCLES_PER_BLOCK = 10.0;
+  constexpr double BUDGET_MS            = 16.0;   // TARGET_FRAME_MS
+  // A frame is not called slower for fewer extra blocks than this (~3 us)
+  constexpr uint64_t REGRESS_FLOOR_BLOCKS = 50;
+
+  // Names the compiler the counts came from; the baseline records it
+  std::string countMode() {
+    char mode[48];
+#if defined(__clang__)
+    std::snprintf(mode, sizeof(mode), "blocks-clang-%d.%d", __clang_major__, __clang_minor__);
+#elif defined(__GNUC__)
+    std::snprintf(mode, sizeof(mode), "blocks-gcc-%d.%d", __GNUC__, __GNUC_MINOR__);
+#else
+    std::snprintf(mode, sizeof(mode), "blocks");
+#endif
+    return mode;
+  }
+
+  uint64_t blocksSoFar() { return *static_cast<volatile uint64_t*>(&gBlocks); }
+
+  // ---------- Corpus ----------
+  // Every entry is deterministic: same seed, same inputs, same frames
+  struct Entry {
+    const char* name;
+    int   game;        // -1: boot and menus on scripted input, else GameID
+    int   cols, rows;  // Big Snake world
+    uint32_t seed;
+    int   frames;
+  };
+
+  const Entry CORPUS[] = {
+    { "menus",     -1, 0, 0, 7, 3000 },
+    { "snake/1",    0, 0, 0, 1, 2000 },
+    { "snake/2",    0, 0, 0, 2, 2000 },
+    { "bigsnake/1", 2, SnakeState::BIG_COLS, SnakeState::BIG_ROWS, 1, 2000 },
+    { "pong/1",     1, 0, 0, 1, 2000 },
+    { "pong/2",     1, 0, 0, 2, 2000 },
+  };
+
+  std::vector<uint64_t> replay(const Entry& e) {
+    Platform::Device::Impl impl;
+    impl.rng = e.seed | 1u;
+    Platform::Device dev(&impl);
+    std::unique_ptr<GameContext> ctx(new GameContext(dev));
+    dev.Init();
+    initGameManager(*ctx);
+
+    std::unique_ptr<Agent> agent;
+    GameID game = static_cast<GameID>(e.game < 0 ? 0 : e.game);
+    if (e.game >= 0) {
+      agent = makeBaselineAgent(game, e.seed);
+      ctx->sys = Flow();
+      ctx->activeGame = game;
+      if (game == GameID::SNAKE) {
+        ctx->games.Emplace<SnakeState>();
+      } else if (game == GameID::BIG_SNAKE) {
+        BigSnakeState& s = ctx->games.Emplace<BigSnakeState>();
+        s.worldCols = e.cols;
+        s.worldRows = e.rows;
+      } else {
+        ctx->games.Emplace<PongState>();
+      }
+      ctx->state = SysState::IN_GAME;
+    }
+
+    std::vector<uint64_t> counts;
+    counts.reserve(e.frames);
+    uint32_t input = e.seed * 2654435761u + 1u;
+    for (int f = 0; f < e.frames; ++f) {
+      if (agent) {
+        if (ctx->state != SysState::IN_GAME) break;
+        Observation obs{game, ctx->games.Get<SnakeState>(), ctx->games.Get<BigSnakeState>(), ctx->games.Get<PongState>(),
+                        impl.fb, impl.now, ctx->currentScore};
+        InputState in = agent->act(obs);
+        impl.buttons[0] = in.buttonA;
+        impl.buttons[1] = in.buttonB;
+      } else {
+        // Sparse presses and the odd two-button hold, as in bloop_runner
+        input ^= input << 13; input ^= input >> 17; input ^= input << 5;
+        impl.buttons[0] = (input & 0x7) == 0;
+        impl.buttons[1] = (input & 0x38) == 0;
+      }
+      uint64_t b0 = blocksSoFar();
+      runGameLoop(*ctx);
+      counts.push_back(blocksSoFar() - b0);
+    }
+    return counts;
+  }
+
+  double predictMs(uint64_t blocks, double cyclesPerBlock) {
+    return blocks * cyclesPerBlock / (ESP_MHZ * 1000.0);
+  }
+
+  // ---------- Baseline ----------
+  // "bloop_budget 2 <mode>", then per entry "entry <name> <frames>" and one
+  // count per line
+  struct Baseline {
+    std::string mode;
+    std::vector<std::pair<std::string, std::vector<uint64_t>>> entries;
+
+    const std::vector<uint64_t>* find(const char* name) const {
+      for (const auto& e : entries) if (e.first == name) return &e.second;
+      return nullptr;
+    }
+  };
+
+  bool loadBaseline(const char* path, Baseline& b) {
+    std::FILE* f = std::fopen(path, "r");
+    if (!f) return false;
+    char mode[32] = {};
+    int version = 0;
+    bool ok = std::fscanf(f, "bloop_budget %d %31s", &version, mode) == 2 && version == 2;
+    b.mode = mode;
+    char name[64];
+    int n = 0;
+    while (ok && std::fscanf(f, " entry %63s %d", name, &n) == 2) {
+      std::vector<uint64_t> counts(n);
+      for (int i = 0; i < n && ok; ++i) {
+        unsigned long long v;
+        ok = std::fscanf(f, "%llu", &v) == 1;
+        counts[i] = v;
+      }
+      b.entries.emplace_back(name, std::move(counts));
+    }
+    std::fclose(f);
+    return ok;
+  }
+
+  bool writeBaseline(const char* path, const std::string& mode, const std::vector<std::vector<uint64_t>>& runs) {
+    std::FILE* f = std::fopen(path, "w");
+    if (!f) return false;
+    std::fprintf(f, "bloop_budget 2 %s\n", mode.c_str());
+    for (size_t i = 0; i < runs.size(); ++i) {
+      std::fprintf(f, "entry %s %zu\n", CORPUS[i].name, runs[i].size());
+      for (uint64_t v : runs[i]) std::fprintf(f, "%llu\n", static_cast<unsigned long long>(v));
+    }
+    std::fclose(f);
+    return true;
+  }
+
+} // anon
+
+int main(int argc, char** argv) {
+  const char* baselinePath = nullptr;
+  const char* writePath = nullptr;
+  double maxRegressPct = 10.0;
+  double cyclesPerBlock = ESP_CYCLES_PER_BLOCK;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    const char* k = argv[i];
+    const char* v = argv[i + 1];
+    if      (!std::strcmp(k, "--baseline"))         baselinePath = v;
+    else if (!std::strcmp(k, "--write-baseline"))   writePath = v;
+    else if (!std::strcmp(k, "--max-regress"))      maxRegressPct = std::atof(v);
+    else if (!std::strcmp(k, "--cycles-per-block")) cyclesPerBlock = std::atof(v);
+    else { std::fprintf(stderr, "unknown option %s\n", k); return 2; }
+  }
+
+  const std::string mode = countMode();
+  const uint64_t probe = blocksSoFar();
+  std::printf("counter         %s, basic blocks from -fsanitize-coverage=trace-pc\n", mode.c_str());
+  std::printf("model           ESP32-C3 %.0f MHz, %.1f cycles per block (assumed, see --cycles-per-block), budget %.0f ms\n",
+              ESP_MHZ, cyclesPerBlock, BUDGET_MS);
+
+  Baseline base;
+  bool haveBase = baselinePath != nullptr;
+  if (haveBase && !loadBaseline(baselinePath, base)) {
+    std::fprintf(stderr, "baseline %s unreadable: record one with --write-baseline (make budget-baseline)\n", baselinePath);
+    return 2;
+  }
+  if (haveBase && base.mode != mode) {
+    std::fprintf(stderr, "baseline %s was counted as %s, this build counts as %s: record it again with this compiler\n",
+                 baselinePath, base.mode.c_str(), mode.c_str());
+    return 2;
+  }
+  if (haveBase) std::printf("baseline        %s\n", baselinePath);
+
+  std::printf("\nentry         frames   p50 ms   p99 ms   max ms  (frame)  over  slower    total\n");
+  std::vector<std::vector<uint64_t>> all;
+  int overTotal = 0, slowerTotal = 0;
+  for (const Entry& e : CORPUS) {
+    std::vector<uint64_t> counts = replay(e);
+    if (blocksSoFar() == probe) {
+      std::fprintf(stderr, "no blocks counted: build with -fsanitize-coverage=trace-pc\n");
+      return 2;
+    }
+
+    const std::vector<uint64_t>* ref = haveBase ? base.find(e.name) : nullptr;
+    std::vector<double> ms(counts.size());
+    int over = 0, slower = 0, worst = 0;
+    uint64_t total = 0, refTotal = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+      total += counts[i];
+      ms[i] = predictMs(counts[i], cyclesPerBlock);
+      if (ms[i] > ms[worst]) worst = static_cast<int>(i);
+      if (ms[i] > BUDGET_MS) over++;
+      if (ref && i < ref->size()) {
+        uint64_t was = (*ref)[i];
+        refTotal += was;
+        if (counts[i] > was * (1.0 + maxRegressPct / 100.0) && counts[i] - was > REGRESS_FLOOR_BLOCKS) slower++;
+      }
+    }
+    // The whole entry: catches a broad slowdown spread thinner than the floor
+    double totalPct = refTotal ? 100.0 * (double(total) - double(refTotal)) / double(refTotal) : 0.0;
+    bool totalSlower = refTotal && totalPct > maxRegressPct;
+    char totalCol[16] = "-";
+    if (ref) std::snprintf(totalCol, sizeof(totalCol), "%+.1f%%%s", totalPct, totalSlower ? "!" : "");
+    std::vector<double> sorted = ms;
+    std::sort(sorted.begin(), sorted.end());
+    double p50 = sorted.empty() ? 0 : sorted[sorted.size() / 2];
+    double p99 = sorted.empty() ? 0 : sorted[sorted.size() * 99 / 100];
+    std::printf("%-12s %7zu %8.3f %8.3f %8.3f  (%5d)  %4d  %6s  %7s\n", e.name, counts.size(), p50, p99,
+                sorted.empty() ? 0 : sorted.back(), worst, over, ref ? std::to_string(slower).c_str() : "-", totalCol);
+    overTotal += over;
+    slowerTotal += slower + (totalSlower ? 1 : 0);
+    all.push_back(std::move(counts));
+  }
+
+  if (writePath) {
+    if (!writeBaseline(writePath, mode, all)) { std::perror(writePath); return 2; }
+    std::printf("\nbaseline written to %s\n", writePath);
+  }
+  bool ok = overTotal == 0 && slowerTotal == 0;
+  std::printf("\n%d frame%s over budget, %d frames or entries more than %.0f%% slower than baseline: %s\n",
+              overTotal, overTotal == 1 ? "" : "s", slowerTotal, maxRegressPct, ok ? "OK" : "FAILED");
+  return ok ? 0 : 1;
+}
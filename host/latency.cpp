@@ -0,0 +1,228 @@
+// Input-to-display latency: for each sample, two identical sessions are
+// driven in lockstep to the same point (boot, menu presses, or a game played
+// by the baseline agent, then a quiet gap with the buttons up). One of them
+// then gets a button edge at a precise virtual time, held for TAP_MS. The
+// first Present() whose framebuffer differs from the untouched twin is the
+// one that shows the press, and its frame time minus the edge time is the
+// latency. It covers input sampling, debounce and cooldowns, move timing
+// (Snake only moves every moveDelay) and frame pacing, up to the start of
+// the Present(); the I2C transfer on the device comes on top.
+//
+// Samples are grouped by game and by the state the console was in at the
+// edge. A press that changes nothing within MAX_WAIT_MS counts as "none"
+// (a debounced press, a turn into a wall that was coming anyway).
+//
+//   bloop_latency [samples per scenario] [--max-p99 MS]
+//
+// With --max-p99 it exits 1 if any group's p99 exceeds the limit.
+
+#include "agent.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+  constexpr unsigned TAP_MS      = 80;     // how long the injected press is held
+  constexpr unsigned QUIET_MS    = 300;    // buttons up before the edge (> debounce)
+  constexpr unsigned MAX_WAIT_MS = 3000;   // give up: the press had no visible effect
+
+  const char* stateName(SysState s) {
+    switch (s) {
+      case SysState::BOOT:      return "BOOT";
+      case SysState::MENU:      return "MENU";
+      case SysState::MENU_OUT:  return "MENU_OUT";
+      case SysState::IN_GAME:   return "IN_GAME";
+      case SysState::GAME_OVER: return "GAME_OVER";
+    }
+    return "?";
+  }
+
+  uint32_t xorshift(uint32_t& x) {
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    return x;
+  }
+
+  // One console; the twins of a sample are built from the same seed
+  struct Session {
+    Platform::Device::Impl impl;
+    Platform::Device dev{&impl};
+    GameContext ctx{dev};
+    std::unique_ptr<Agent> agent;
+
+    explicit Session(uint32_t seed) {
+      impl.rng = seed | 1u;
+      dev.Init();
+      initGameManager(ctx);
+    }
+
+    void boot() {
+      while (ctx.sys.Running() || ctx.state != SysState::MENU) runGameLoop(ctx);
+    }
+
+    // Straight into a game, as the other host tools do
+    void enter(GameID game, uint32_t seed) {
+      ctx.sys = Flow();
+      ctx.activeGame = game;
+      if (game == GameID::SNAKE) {
+        ctx.games.Emplace<SnakeState>();
+      } else if (game == GameID::BIG_SNAKE) {
+        ctx.games.Emplace<BigSnakeState>();
+      } else {
+        ctx.games.Emplace<PongState>();
+      }
+      ctx.gameInited = false;
+      ctx.currentScore = 0;
+      ctx.exitReq = ctx.gameOver = false;
+      ctx.state = SysState::IN_GAME;
+      agent = makeBaselineAgent(game, seed);
+    }
+
+    // One frame; true if it presented
+    bool frame(bool a, bool b) {
+      impl.buttons[0] = a;
+      impl.buttons[1] = b;
+      uint64_t before = impl.presents.sent + impl.presents.skipped;
+      runGameLoop(ctx);
+      return impl.presents.sent + impl.presents.skipped != before;
+    }
+
+    void play() {
+      InputState in;
+      if (agent && ctx.state == SysState::IN_GAME) {
+        Observation obs{ctx.activeGame, ctx.games.Get<SnakeState>(), ctx.games.Get<BigSnakeState>(), ctx.games.Get<PongState>(),
+                        impl.fb, impl.now, ctx.currentScore};
+        in = agent->act(obs);
+      }
+      frame(in.buttonA, in.buttonB);
+    }
+  };
+
+  enum class Press { A, B, TOWARDS_MIDDLE };   // the last: Pong's paddle, away from the wall
+
+  struct Scenario {
+    const char* name;
+    int   game;        // -1: menu, else GameID
+    Press press;
+  };
+
+  const Scenario SCENARIOS[] = {
+    { "menu",     -1, Press::B },   // cursor down
+    { "menu",     -1, Press::A },   // pick: menu slide-out or Sleep
+    { "snake",     0, Press::A },   // turn
+    { "snake",     0, Press::B },
+    { "bigsnake",  2, Press::A },
+    { "pong",      1, Press::TOWARDS_MIDDLE },
+  };
+
+  struct Sample {
+    std::string group;
+    bool     seen = false;
+    unsigned latencyMs = 0;   // edge to the Present() showing it
+    unsigned sampledMs = 0;   // edge to the first frame that read it
+  };
+
+  Sample measure(const Scenario& sc, uint32_t seed) {
+    std::unique_ptr<Session> p(new Session(seed)), q(new Session(seed));
+    Session& probe = *p;
+    Session& twin = *q;
+    probe.boot();
+    twin.boot();
+    uint32_t r = seed * 2654435761u + 1u;
+
+    // A different lead-in per sample, so the edge lands at every phase of
+    // the frame, the move timer and the Pong tick
+    if (sc.game < 0) {
+      int taps = xorshift(r) % MENU_COUNT;
+      for (int t = 0; t < taps; ++t) {
+        for (int f = 0; f < 3; ++f) { probe.frame(false, true); twin.frame(false, true); }
+        for (int f = 0; f < 15; ++f) { probe.frame(false, false); twin.frame(false, false); }
+      }
+    } else {
+      GameID game = static_cast<GameID>(sc.game);
+      probe.enter(game, seed);
+      twin.enter(game, seed);
+      int frames = 80 + static_cast<int>(xorshift(r) % 400);
+      for (int f = 0; f < frames; ++f) { probe.play(); twin.play(); }
+    }
+    // The first frame starting at or after the edge is the one that reads it
+    uint64_t edge = probe.impl.now + QUIET_MS + xorshift(r) % 200;
+    while (probe.impl.now < edge) { probe.frame(false, false); twin.frame(false, false); }
+
+    Sample s;
+    s.group = std::string(sc.name) + " " + stateName(probe.ctx.state);
+    bool a = sc.press == Press::A;
+    if (sc.press == Press::TOWARDS_MIDDLE) {
+      const PongState* p = probe.ctx.games.Get<PongState>();
+      a = p && p->player.y > Platform::SCREEN_HEIGHT / 2;
+    }
+    bool sampled = false;
+    while (probe.impl.now - edge <= MAX_WAIT_MS) {
+      uint64_t t = probe.impl.now;
+      bool down = t - edge < TAP_MS;
+      if (down && !sampled) { s.sampledMs = static_cast<unsigned>(t - edge); sampled = true; }
+      bool presented = probe.frame(down && a, down && !a);
+      twin.frame(false, false);
+      if (presented && std::memcmp(probe.impl.fb, twin.impl.fb, sizeof(probe.impl.fb)) != 0) {
+        s.seen = true;
+        s.latencyMs = static_cast<unsigned>(t - edge);
+        break;
+      }
+    }
+    return s;
+  }
+
+  unsigned percentile(const std::vector<unsigned>& sorted, int pct) {
+    if (sorted.empty()) return 0;
+    return sorted[std::min(sorted.size() - 1, sorted.size() * pct / 100)];
+  }
+
+} // anon
+
+int main(int argc, char** argv) {
+  int samples = 300;
+  double maxP99 = 0;
+  for (int i = 1; i < argc; ++i) {
+    if (!std::strcmp(argv[i], "--max-p99") && i + 1 < argc) maxP99 = std::atof(argv[++i]);
+    else samples = std::atoi(argv[i]);
+  }
+
+  struct Group {
+    std::string name;
+    std::vector<unsigned> ms;
+    long long sampledSum = 0;
+    int none = 0;
+  };
+  std::vector<Group> groups;
+  for (const Scenario& sc : SCENARIOS) {
+    for (int i = 0; i < samples; ++i) {
+      Sample s = measure(sc, 1000u + static_cast<uint32_t>(i) * 7919u);
+      auto g = std::find_if(groups.begin(), groups.end(), [&](const Group& x) { return x.name == s.group; });
+      if (g == groups.end()) { groups.push_back(Group{s.group, {}, 0, 0}); g = groups.end() - 1; }
+      if (!s.seen) { g->none++; continue; }
+      g->ms.push_back(s.latencyMs);
+      g->sampledSum += s.sampledMs;
+    }
+  }
+
+  std::printf("%d samples per scenario, press held %u ms after %u+ ms with the buttons up\n\n",
+              samples, TAP_MS, QUIET_MS);
+  std::printf("game/state          samples  none   read ms   p50 ms   p99 ms   max ms\n");
+  bool ok = true;
+  for (Group& g : groups) {
+    std::sort(g.ms.begin(), g.ms.end());
+    unsigned p99 = percentile(g.ms, 99);
+    bool over = maxP99 > 0 && !g.ms.empty() && p99 > maxP99;
+    ok = ok && !over;
+    std::printf("%-19s %7zu  %4d  %8.1f %8u %8u %8u%s\n", g.name.c_str(), g.ms.size() + g.none, g.none,
+                g.ms.empty() ? 0.0 : double(g.sampledSum) / g.ms.size(), percentile(g.ms, 50), p99,
+                g.ms.empty() ? 0u : g.ms.back(), over ? "  !" : "");
+  }
+  std::printf("\n\"read\" is the mean wait for the first frame to sample the press\n");
+  if (maxP99 > 0) std::printf("p99 limit %.0f ms: %s\n", maxP99, ok ? "OK" : "FAILED");
+  return ok ? 0 : 1;
+}
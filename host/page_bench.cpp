@@ -0,0 +1,280 @@
+// Page-mode renderer vs full framebuffer: every scene is drawn through both
+// (Raster on a 1 KB buffer, DisplayList replayed page by page). Each
+// Present() sends only the pages its backend reports changed, as the
+// hardware does, into a model of the panel's RAM; after every frame both
+// panels must be pixel-identical to the full framebuffer, so a missed
+// change fails. Then RAM, time and pages sent per frame are reported.
+// Scenes mirror the game's draw sequences; "fuzz" throws random primitives
+// (off-screen, both colours, all scales) at both; "tiles" is Snake on the
+// tile-map layer, against "snake" redrawing every cell.
+//
+//   page_bench [frames]
+
+#include "assets.h"
+#include "display_list.h"
+#include "tilemap.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+  constexpr int W = Raster::WIDTH, H = Raster::HEIGHT, BAR = 16;
+
+  using SnakeMap = Raster::TileMap<32, 12>;
+
+  // Pages of a frame written into the panel's RAM (the I2C page writes)
+  void sendPages(uint8_t* panel, const uint8_t* src, uint8_t pages, long& sent) {
+    for (int p = 0; p < Raster::PAGES; ++p) {
+      if (!(pages & (1u << p))) continue;
+      std::memcpy(panel + p * W, src + p * W, W);
+      sent++;
+    }
+  }
+
+  bool samePanel(const char* scene, const char* which, int f, const uint8_t* want, const uint8_t* got) {
+    if (std::memcmp(want, got, Raster::BYTES) == 0) return true;
+    int i = 0;
+    while (want[i] == got[i]) ++i;
+    std::printf("%-6s %s panel MISMATCH at frame %d (page %d, x %d: %02x vs %02x)\n",
+                scene, which, f, i / W, i % W, want[i], got[i]);
+    return false;
+  }
+
+  struct Full {
+    uint8_t fb[Raster::BYTES] = {};
+    uint8_t panel[Raster::BYTES] = {};
+    uint8_t dirty = 0;
+    long    pagesSent = 0;
+    SnakeMap tiles;
+    void Clear()                                      { dirty |= Raster::Clear(fb); }
+    void SetPixel(int x, int y, bool on)              { dirty |= Raster::SetPixel(fb, x, y, on); }
+    void FillRect(int x, int y, int w, int h, bool on) { dirty |= Raster::FillRect(fb, x, y, w, h, on); }
+    void DrawRect(int x, int y, int w, int h, bool on) { dirty |= Raster::DrawRect(fb, x, y, w, h, on); }
+    void DrawLine(int a, int b, int c, int d, bool on) { dirty |= Raster::DrawLine(fb, a, b, c, d, on); }
+    void DrawText(int x, int y, const char* t, int s, bool on) { dirty |= Raster::DrawText(fb, x, y, t, s, on); }
+    void DrawSprite(int x, int y, const Raster::Sprite& s, Raster::Rop op) { dirty |= Raster::DrawSprite(fb, x, y, s, op); }
+    void DrawLayer(SnakeMap& m) { dirty |= m.Draw(fb); }
+    void Present() {
+      sendPages(panel, fb, dirty, pagesSent);
+      dirty = 0;
+    }
+  };
+
+  struct Paged {
+    Raster::DisplayList list;
+    uint8_t page[W] = {};
+    uint8_t panel[Raster::BYTES] = {};  // what the SSD1306 would hold
+    long    pagesSent = 0;
+    SnakeMap tiles;
+    void Clear()                                      { list.Clear(); }
+    void SetPixel(int x, int y, bool on)              { list.SetPixel(x, y, on); }
+    void FillRect(int x, int y, int w, int h, bool on) { list.FillRect(x, y, w, h, on); }
+    void DrawRect(int x, int y, int w, int h, bool on) { list.DrawRect(x, y, w, h, on); }
+    void DrawLine(int a, int b, int c, int d, bool on) { list.DrawLine(a, b, c, d, on); }
+    void DrawText(int x, int y, const char* t, int s, bool on) { list.DrawText(x, y, t, s, on); }
+    void DrawSprite(int x, int y, const Raster::Sprite& s, Raster::Rop op) { list.DrawSprite(x, y, s, op); }
+    void DrawLayer(SnakeMap& m) {
+      list.DrawLayer(&m, &SnakeMap::Band, m.X(), m.Y(), m.Width(), m.Height(), m.DirtyPages());
+      m.ClearDirty();
+    }
+    void Present() {
+      uint8_t pages = list.TakeChanged();
+      for (int p = 0; p < Raster::PAGES; ++p) {
+        if (!(pages & (1u << p))) continue;
+        list.RenderPage(p, page);
+        std::memcpy(panel + p * W, page, W);
+        pagesSent++;
+      }
+    }
+  };
+
+  template <typename D> void statusBar(D& d, int score, int high) {
+    char buf[16];
+    d.FillRect(0, 0, W, BAR, false);
+    d.DrawText(0, 2, "HSC:", 1, true);
+    std::snprintf(buf, sizeof(buf), "%d", high);  d.DrawText(24, 2, buf, 1, true);
+    d.DrawText(50, 2, "Scr:", 1, true);
+    std::snprintf(buf, sizeof(buf), "%d", score); d.DrawText(75, 2, buf, 1, true);
+    d.DrawText(110, 2, "BAT", 1, true);
+  }
+
+  template <typename D> void snakeFrame(D& d, int f) {
+    d.FillRect(0, BAR, W, H - BAR, false);
+    statusBar(d, 17, 42);
+    for (int i = 0; i < 20; ++i) d.FillRect(((f / 4 + i) % 32) * 4, ((i / 8) % 12) * 4 + BAR, 4, 4, true);
+    d.FillRect((f * 7) % 32 * 4, BAR + 20, 4, 4, true);
+    d.Present();
+  }
+
+  // Snake as the game draws it now: a 20-cell body crawling through the map
+  // and a food cell that jumps every 16 frames, only changed cells redrawn
+  template <typename D> void tilesFrame(D& d, int f) {
+    auto cell = [&](int i, uint8_t t) { i %= 32 * 12; d.tiles.Set(i % 32, i / 32, t); };
+    if (f == 0) {
+      d.FillRect(0, BAR, W, H - BAR, false);
+      d.tiles.Init(Assets::SNAKE_TILES, 0, BAR);
+    }
+    if (f >= 20) cell(f - 20, 0);
+    cell(f, 1);
+    if (f % 16 == 0) {
+      int old = (f / 16 * 97 + 103) % (32 * 12), food = (old + 97) % (32 * 12);
+      if (f && d.tiles.Get(old % 32, old / 32) == 2) cell(old, 0);
+      if (d.tiles.Get(food % 32, food / 32) == 0) cell(food, 2);
+    }
+    statusBar(d, 17, 42);
+    d.DrawLayer(d.tiles);
+    d.Present();
+  }
+
+  template <typename D> void pongFrame(D& d, int f) {
+    d.FillRect(0, BAR, W, H - BAR, false);
+    statusBar(d, 5, 12);
+    for (int x = 0; x < W; x += 4) { d.FillRect(x, BAR, 2, 1, true); d.FillRect(x, H - 1, 2, 1, true); }
+    for (int y = BAR; y < H; y += 4) { d.FillRect(0, y, 1, 2, true); d.FillRect(W - 1, y, 1, 2, true); }
+    for (int y = BAR; y < H; y += 4) d.SetPixel(W / 2, y, true);
+    int y = BAR + (f % (H - BAR - 10));
+    d.FillRect(3, y, 2, 10, true);
+    d.FillRect(W - 5, y, 2, 10, true);
+    d.FillRect(f % W, y + 4, 2, 2, true);
+    d.Present();
+  }
+
+  // Pong as the game draws it now: the court once, then paddles and ball
+  // XOR-erased and redrawn every frame
+  template <typename D> void xorMovers(D& d, int f) {
+    int y = BAR + (f % (H - BAR - 10));
+    d.DrawSprite(3, y, Assets::PADDLE, Raster::Rop::XOR);
+    d.DrawSprite(W - 5, H - 10 - (f % (H - BAR - 10)), Assets::PADDLE, Raster::Rop::XOR);
+    d.DrawSprite((f * 3) % W, BAR + (f * 7) % (H - BAR - 2), Assets::BALL, Raster::Rop::XOR);
+  }
+
+  template <typename D> void xorFrame(D& d, int f) {
+    if (f == 0) {
+      d.FillRect(0, BAR, W, H - BAR, false);
+      for (int x = 0; x < W; x += 4) { d.FillRect(x, BAR, 2, 1, true); d.FillRect(x, H - 1, 2, 1, true); }
+      for (int y = BAR; y < H; y += 4) { d.FillRect(0, y, 1, 2, true); d.FillRect(W - 1, y, 1, 2, true); }
+      for (int y = BAR; y < H; y += 4) d.SetPixel(W / 2, y, true);
+    } else {
+      xorMovers(d, f - 1);
+    }
+    statusBar(d, f / 50, 12);
+    xorMovers(d, f);
+    d.Present();
+  }
+
+  // Boot slide, menu, then the exit bar drawn over whatever is on screen
+  template <typename D> void uiFrame(D& d, int f) {
+    int phase = (f / 40) % 3;
+    if (phase == 0) {
+      d.Clear();
+      d.DrawSprite((f % 40) * 5 - 60, 25 + f % 8, Assets::LOGO, Raster::Rop::OR);
+    } else if (phase == 1) {
+      d.Clear();
+      d.FillRect(0, 0, W, BAR, false);
+      d.DrawText(48, 2, "BLOOP", 1, true);
+      d.DrawText(110, 2, "BAT", 1, true);
+      const char* items[] = { "1.Snake", "2.Pong", "3.Sleep" };
+      for (int i = 0; i < 3; ++i) {
+        d.DrawText(0, BAR + 5 + i * 10, i == f % 3 ? "> " : "  ", 1, true);
+        d.DrawText(12, BAR + 5 + i * 10, items[i], 1, true);
+      }
+    } else {
+      d.FillRect(0, H - 2, W, 2, false);
+      d.DrawLine(0, H - 1, (f % 40) * W / 40, H - 1, true);
+    }
+    d.Present();
+  }
+
+  uint32_t gRng = 1;
+  int rnd(int lo, int hi) {
+    gRng ^= gRng << 13; gRng ^= gRng >> 17; gRng ^= gRng << 5;
+    return lo + static_cast<int>(gRng % static_cast<uint32_t>(hi - lo));
+  }
+
+  template <typename D> void fuzzFrame(D& d, int f) {
+    if (f % 8 == 0) d.Clear();
+    for (int i = 0; i < 6; ++i) {
+      bool on = rnd(0, 4) != 0;
+      int x = rnd(-40, W + 20), y = rnd(-20, H + 10);
+      switch (rnd(0, 6)) {
+        case 0: d.SetPixel(x, y, on); break;
+        case 1: d.FillRect(x, y, rnd(-2, 60), rnd(-2, 30), on); break;
+        case 2: d.DrawRect(x, y, rnd(-2, 60), rnd(-2, 30), on); break;
+        case 3: d.DrawLine(x, y, rnd(-40, W + 40), rnd(-20, H + 20), on); break;
+        case 4: d.DrawSprite(x, y, Assets::LOGO, static_cast<Raster::Rop>(rnd(0, 3))); break;
+        default: {
+          static const char* words[] = { "Hi", "Score: 12", "A\nB", "~?!", "BLOOP" };
+          d.DrawText(x, y, words[rnd(0, 5)], rnd(1, 4), on);
+        }
+      }
+    }
+    d.Present();
+  }
+
+  template <typename D, typename F>
+  double nsPerFrame(D& d, int frames, F frame) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; ++f) frame(d, f);
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / frames;
+  }
+
+  struct Scene {
+    const char* name;
+    void (*full)(Full&, int);
+    void (*paged)(Paged&, int);
+  };
+
+  bool runScene(const Scene& s, int frames) {
+    static Full  full;
+    static Paged paged;
+    full = Full{};
+    paged = Paged{};
+
+    // Identity check, frame by frame
+    gRng = 12345;
+    Full ref{};
+    for (int f = 0; f < frames; ++f) {
+      uint32_t rng = gRng;
+      s.full(ref, f);
+      gRng = rng;
+      s.paged(paged, f);
+      if (paged.list.Overflows()) {
+        std::printf("%-6s display list overflow at frame %d\n", s.name, f);
+        return false;
+      }
+      if (!samePanel(s.name, "paged", f, ref.fb, paged.panel) ||
+          !samePanel(s.name, "full", f, ref.fb, ref.panel))
+        return false;
+    }
+
+    full = Full{};
+    Paged timed{};
+    gRng = 12345; double fullNs  = nsPerFrame(full,  frames, s.full);
+    gRng = 12345; double pagedNs = nsPerFrame(timed, frames, s.paged);
+    std::printf("%-6s full %7.0f ns   paged %7.0f ns (x%.1f)   list high-water %4d B   pages/frame %.2f\n",
+                s.name, fullNs, pagedNs, pagedNs / fullNs, paged.list.HighWater(),
+                double(paged.pagesSent) / frames);
+    return true;
+  }
+
+} // anon
+
+int main(int argc, char** argv) {
+  int frames = argc > 1 ? std::atoi(argv[1]) : 2000;
+  const Scene scenes[] = {
+    { "snake", snakeFrame<Full>, snakeFrame<Paged> },
+    { "tiles", tilesFrame<Full>, tilesFrame<Paged> },
+    { "pong",  pongFrame<Full>,  pongFrame<Paged>  },
+    { "xor",   xorFrame<Full>,   xorFrame<Paged>   },
+    { "ui",    uiFrame<Full>,    uiFrame<Paged>    },
+    { "fuzz",  fuzzFrame<Full>,  fuzzFrame<Paged>  },
+  };
+  std::printf("RAM   full framebuffer %d B   page mode %d B (list %d + page %d)\n",
+              Raster::BYTES, Raster::DisplayList::CAPACITY + W, Raster::DisplayList::CAPACITY, W);
+  bool ok = true;
+  for (const Scene& s : scenes) ok = runScene(s, frames) && ok;
+  std::printf(ok ? "pixel-identical OK\n" : "FAILED\n");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include "platform_host.h"
+#include "ssd1306.h"
+#include <cstring>
+
+// Command-stream model of the SSD1306: parses the bytes a session sends
+// (commands with their parameters, horizontal-mode data writes) into GDDRAM
+// and tracks the horizontal scroll against the clock, so Visible() is what
+// the glass would show at a given time. Counts bus bytes and the misuse the
+// datasheet warns about (writing RAM while a scroll runs).
+class PanelModel : public Platform::PanelSink {
+public:
+  static constexpr int W = Raster::WIDTH, PAGES = Raster::PAGES;
+
+  void Command(const uint8_t* bytes, int n, uint64_t now) override {
+    bus_ += n + 1;  // + control byte
+    for (int i = 0; i < n; ++i) {
+      cmd_[len_++] = bytes[i];
+      if (len_ == 1) need_ = params(cmd_[0]);
+      if (len_ > need_) { execute(now); len_ = 0; }
+    }
+  }
+
+  void Data(const uint8_t* bytes, int n, uint64_t) override {
+    bus_ += n + 1;
+    if (scrolling_) writesWhileScrolling_++;
+    for (int i = 0; i < n; ++i) {
+      ram_[page_ * W + col_] = bytes[i];
+      if (++col_ > colEnd_) {
+        col_ = colStart_;
+        if (++page_ > pageEnd_) page_ = pageStart_;
+      }
+    }
+  }
+
+  void Frame(uint64_t now) override {
+    Visible(frame_, now);
+    frames_++;
+  }
+
+  // The picture at time now: RAM with the running scroll applied
+  void Visible(uint8_t* out, uint64_t now) const {
+    std::memcpy(out, ram_, sizeof(ram_));
+    if (scrolling_) Raster::ScrollPages(out, scrollFirst_, scrollLast_, shifted(now), true);
+  }
+
+  const uint8_t* LastFrame() const { return frame_; }
+  uint32_t Frames() const             { return frames_; }
+  uint64_t BusBytes() const           { return bus_; }
+  uint32_t WritesWhileScrolling() const { return writesWhileScrolling_; }
+  bool     Scrolling() const          { return scrolling_; }
+
+private:
+  static int params(uint8_t c) {
+    switch (c) {
+      case SSD1306::COLUMN_ADDR: case SSD1306::PAGE_ADDR: case 0xA3: return 2;
+      case SSD1306::SCROLL_RIGHT: case SSD1306::SCROLL_LEFT: return 6;
+      case 0x29: case 0x2A: return 5;
+      case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+      case 0xD5: case 0xD9: case 0xDA: case 0xDB: return 1;
+      default: return 0;
+    }
+  }
+
+  int shifted(uint64_t now) const {
+    int cols = static_cast<int>((now - scrollStart_) / msPerColumn_) % W;
+    return scrollRight_ ? cols : -cols;
+  }
+
+  void execute(uint64_t now) {
+    switch (cmd_[0]) {
+      case SSD1306::COLUMN_ADDR:
+        colStart_ = col_ = cmd_[1] & (W - 1); colEnd_ = cmd_[2] & (W - 1);
+        break;
+      case SSD1306::PAGE_ADDR:
+        pageStart_ = page_ = cmd_[1] & (PAGES - 1); pageEnd_ = cmd_[2] & (PAGES - 1);
+        break;
+      case SSD1306::SCROLL_RIGHT: case SSD1306::SCROLL_LEFT:
+        scrollRight_ = cmd_[0] == SSD1306::SCROLL_RIGHT;
+        scrollFirst_ = cmd_[2] & (PAGES - 1);
+        scrollLast_  = cmd_[4] & (PAGES - 1);
+        msPerColumn_ = SSD1306::INTERVAL_FRAMES[cmd_[3] & 7] * SSD1306::FRAME_MS;
+        break;
+      case SSD1306::SCROLL_ON:
+        scrolling_ = true;
+        scrollStart_ = now;
+        break;
+      case SSD1306::SCROLL_OFF:
+        // The shift so far stays in RAM; the datasheet asks for a rewrite
+        if (scrolling_) Raster::ScrollPages(ram_, scrollFirst_, scrollLast_, shifted(now), true);
+        scrolling_ = false;
+        break;
+    }
+  }
+
+  uint8_t  ram_[Raster::BYTES] = {};
+  uint8_t  frame_[Raster::BYTES] = {};
+  uint8_t  cmd_[8] = {};
+  int      len_ = 0, need_ = 0;
+  int      colStart_ = 0, colEnd_ = W - 1, col_ = 0;
+  int      pageStart_ = 0, pageEnd_ = PAGES - 1, page_ = 0;
+  bool     scrolling_ = false, scrollRight_ = true;
+  int      scrollFirst_ = 0, scrollLast_ = 0;
+  unsigned msPerColumn_ = 20;
+  uint64_t scrollStart_ = 0;
+  uint64_t bus_ = 0;
+  uint32_t frames_ = 0;
+  uint32_t writesWhileScrolling_ = 0;
+};
@@ -0,0 +1,203 @@
+#include "pong_batch.h"
+#include "Pong.h"
+#include "platform.h"
+
+#if defined(__AVX2__)
+  #include <immintrin.h>
+#elif defined(__SSE4_1__)
+  #include <smmintrin.h>
+#elif defined(__wasm_simd128__)
+  #include <wasm_simd128.h>
+#endif
+
+using namespace Platform;
+
+namespace {
+  constexpr int PADDLE_HEIGHT = PongState::PADDLE_HEIGHT;
+  constexpr int PADDLE_WIDTH  = PongState::PADDLE_WIDTH;
+  constexpr int BALL_SIZE     = PongState::BALL_SIZE;
+  constexpr int PADDLE_OFFSET = PongState::PADDLE_OFFSET;
+  constexpr int PADDLE_SPEED  = PongState::PADDLE_SPEED_BASE;  // at SpeedScale() == 1
+  constexpr int CPU_X    = PADDLE_OFFSET;
+  constexpr int PLAYER_X = SCREEN_WIDTH - PADDLE_WIDTH - PADDLE_OFFSET;
+
+  // ---- Lane abstraction: masks are all-ones / all-zeros per 32-bit lane ----
+#if defined(__AVX2__)
+  constexpr int LANES = 8;
+  constexpr const char* ISA = "avx2";
+  struct V { __m256i v; };
+  inline V load(const int32_t* p)    { return {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))}; }
+  inline void store(int32_t* p, V a) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), a.v); }
+  inline V set1(int32_t x)           { return {_mm256_set1_epi32(x)}; }
+  inline V add(V a, V b)             { return {_mm256_add_epi32(a.v, b.v)}; }
+  inline V sub(V a, V b)             { return {_mm256_sub_epi32(a.v, b.v)}; }
+  inline V gt(V a, V b)              { return {_mm256_cmpgt_epi32(a.v, b.v)}; }
+  inline V and_(V a, V b)            { return {_mm256_and_si256(a.v, b.v)}; }
+  inline V or_(V a, V b)             { return {_mm256_or_si256(a.v, b.v)}; }
+  inline V andnot(V m, V a)          { return {_mm256_andnot_si256(m.v, a.v)}; }  // ~m & a
+  inline V select(V m, V a, V b)     { return {_mm256_blendv_epi8(a.v, b.v, m.v)}; } // m ? b : a
+  inline V vabs(V a)                 { return {_mm256_abs_epi32(a.v)}; }
+  inline V vmax(V a, V b)            { return {_mm256_max_epi32(a.v, b.v)}; }
+  inline V vmin(V a, V b)            { return {_mm256_min_epi32(a.v, b.v)}; }
+#elif defined(__SSE4_1__)
+  constexpr int LANES = 4;
+  constexpr const char* ISA = "sse4.1";
+  struct V { __m128i v; };
+  inline V load(const int32_t* p)    { return {_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))}; }
+  inline void store(int32_t* p, V a) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), a.v); }
+  inline V set1(int32_t x)           { return {_mm_set1_epi32(x)}; }
+  inline V add(V a, V b)             { return {_mm_add_epi32(a.v, b.v)}; }
+  inline V sub(V a, V b)             { return {_mm_sub_epi32(a.v, b.v)}; }
+  inline V gt(V a, V b)              { return {_mm_cmpgt_epi32(a.v, b.v)}; }
+  inline V and_(V a, V b)            { return {_mm_and_si128(a.v, b.v)}; }
+  inline V or_(V a, V b)             { return {_mm_or_si128(a.v, b.v)}; }
+  inline V andnot(V m, V a)          { return {_mm_andnot_si128(m.v, a.v)}; }
+  inline V select(V m, V a, V b)     { return {_mm_blendv_epi8(a.v, b.v, m.v)}; }
+  inline V vabs(V a)                 { return {_mm_abs_epi32(a.v)}; }
+  inline V vmax(V a, V b)            { return {_mm_max_epi32(a.v, b.v)}; }
+  inline V vmin(V a, V b)            { return {_mm_min_epi32(a.v, b.v)}; }
+#elif defined(__wasm_simd128__)
+  constexpr int LANES = 4;
+  constexpr const char* ISA = "simd128";
+  struct V { v128_t v; };
+  inline V load(const int32_t* p)    { return {wasm_v128_load(p)}; }
+  inline void store(int32_t* p, V a) { wasm_v128_store(p, a.v); }
+  inline V set1(int32_t x)           { return {wasm_i32x4_splat(x)}; }
+  inline V add(V a, V b)             { return {wasm_i32x4_add(a.v, b.v)}; }
+  inline V sub(V a, V b)             { return {wasm_i32x4_sub(a.v, b.v)}; }
+  inline V gt(V a, V b)              { return {wasm_i32x4_gt(a.v, b.v)}; }
+  inline V and_(V a, V b)            { return {wasm_v128_and(a.v, b.v)}; }
+  inline V or_(V a, V b)             { return {wasm_v128_or(a.v, b.v)}; }
+  inline V andnot(V m, V a)          { return {wasm_v128_andnot(a.v, m.v)}; }
+  inline V select(V m, V a, V b)     { return {wasm_v128_bitselect(b.v, a.v, m.v)}; }
+  inline V vabs(V a)                 { return {wasm_i32x4_abs(a.v)}; }
+  inline V vmax(V a, V b)            { return {wasm_i32x4_max(a.v, b.v)}; }
+  inline V vmin(V a, V b)            { return {wasm_i32x4_min(a.v, b.v)}; }
+#else
+  constexpr int LANES = 1;
+  constexpr const char* ISA = "scalar";
+  struct V { int32_t v; };
+  inline V load(const int32_t* p)    { return {*p}; }
+  inline void store(int32_t* p, V a) { *p = a.v; }
+  inline V set1(int32_t x)           { return {x}; }
+  inline V add(V a, V b)             { return {a.v + b.v}; }
+  inline V sub(V a, V b)             { return {a.v - b.v}; }
+  inline V gt(V a, V b)              { return {-static_cast<int32_t>(a.v > b.v)}; }
+  inline V and_(V a, V b)            { return {a.v & b.v}; }
+  inline V or_(V a, V b)             { return {a.v | b.v}; }
+  inline V andnot(V m, V a)          { return {~m.v & a.v}; }
+  inline V select(V m, V a, V b)     { return {(a.v & ~m.v) | (b.v & m.v)}; }
+  inline V vabs(V a)                 { return {a.v < 0 ? -a.v : a.v}; }
+  inline V vmax(V a, V b)            { return {a.v > b.v ? a.v : b.v}; }
+  inline V vmin(V a, V b)            { return {a.v < b.v ? a.v : b.v}; }
+#endif
+
+  inline V lt(V a, V b) { return gt(b, a); }
+  inline V neg(V a)     { return sub(set1(0), a); }
+
+} // anon
+
+void PongBatch::reset(int n, uint32_t seed) {
+  count  = n;
+  padded = (n + LANES - 1) / LANES * LANES;
+  PongState court;
+  resetPongCourt(court);
+  ballX.assign(padded, court.ball.x);
+  ballY.assign(padded, court.ball.y);
+  ballVX.assign(padded, -1);
+  ballVY.assign(padded, 1);
+  cpuY.assign(padded, court.cpu.y);
+  playerY.assign(padded, court.player.y);
+  score.assign(padded, 0);
+  alive.assign(padded, 0);
+  uint32_t x = seed | 1u;
+  for (int i = 0; i < n; ++i) {
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    ballVY[i] = (x & 1) ? 1 : -1;
+    alive[i]  = -1;
+  }
+}
+
+int         pongBatchLanes() { return LANES; }
+const char* pongBatchIsa()   { return ISA; }
+
+int pongAutopilotY(int playerY, int ballY) {
+  int bc = ballY + BALL_SIZE/2;
+  int pc = playerY + PADDLE_HEIGHT/2;
+  if (bc < pc && playerY > STATUS_BAR_HEIGHT + 2) return playerY - PADDLE_SPEED;
+  if (bc > pc && playerY < SCREEN_HEIGHT - PADDLE_HEIGHT - 2) return playerY + PADDLE_SPEED;
+  return playerY;
+}
+
+void pongBatchTick(PongBatch& b, int first, int last) {
+  const V cpuX      = set1(CPU_X);
+  const V playerX   = set1(PLAYER_X);
+  const V halfBall  = set1(BALL_SIZE/2);
+  const V halfPad   = set1(PADDLE_HEIGHT/2);
+  const V padH      = set1(PADDLE_HEIGHT);
+  const V padW      = set1(PADDLE_WIDTH);
+  const V ballSz    = set1(BALL_SIZE);
+  const V one       = set1(1);
+  const V speedP    = set1(PADDLE_SPEED);
+  const V top       = set1(STATUS_BAR_HEIGHT);
+  const V cpuMax    = set1(SCREEN_HEIGHT - PADDLE_HEIGHT);
+  const V wallLo    = set1(STATUS_BAR_HEIGHT + 1);            // y <= top  <=> y < top+1
+  const V wallHi    = set1(SCREEN_HEIGHT - BALL_SIZE - 1);     // y >= 62   <=> y > 61
+  const V playerLo  = set1(STATUS_BAR_HEIGHT + 2);
+  const V playerHi  = set1(SCREEN_HEIGHT - PADDLE_HEIGHT - 2);
+  const V courtW    = set1(SCREEN_WIDTH);
+  const V zero      = set1(0);
+
+  for (int i = first; i < last; i += LANES) {
+    V live = load(&b.alive[i]);
+    V bx = load(&b.ballX[i]),  by = load(&b.ballY[i]);
+    V vx = load(&b.ballVX[i]), vy = load(&b.ballVY[i]);
+    V cy = load(&b.cpuY[i]),   py = load(&b.playerY[i]);
+    V sc = load(&b.score[i]);
+
+    // Autopilot player (input phase, before the physics tick)
+    V bc = add(by, halfBall);
+    V pc = add(py, halfPad);
+    V up   = and_(lt(bc, pc), gt(py, playerLo));
+    V down = and_(andnot(up, gt(bc, pc)), lt(py, playerHi));
+    V npy = add(sub(py, and_(up, speedP)), and_(down, speedP));
+
+    // updateCPU
+    V cc = add(cy, halfPad);
+    V speed = vmax(one, vabs(vx));
+    V ncy = add(sub(cy, and_(lt(bc, cc), speed)), and_(gt(bc, cc), speed));
+    ncy = vmin(vmax(ncy, top), cpuMax);
+
+    // updateBall: move, bounce off top/bottom
+    V nbx = add(bx, vx), nby = add(by, vy);
+    V wall = or_(lt(nby, wallLo), gt(nby, wallHi));
+    V nvy = select(wall, vy, neg(vy));
+    V nvx = vx;
+
+    // CPU paddle: x <= cpu.x+W && y+B >= cpu.y && y <= cpu.y+H
+    V cpuEdge = add(cpuX, padW);
+    V hitC = andnot(gt(nbx, cpuEdge),
+             andnot(lt(add(nby, ballSz), ncy), andnot(gt(nby, add(ncy, padH)), live)));
+    nbx = select(hitC, nbx, cpuEdge);
+    nvx = select(hitC, nvx, neg(nvx));
+
+    // Player paddle: x+B >= player.x && y+B >= player.y && y <= player.y+H
+    V hitP = andnot(lt(add(nbx, ballSz), playerX),
+             andnot(lt(add(nby, ballSz), npy), andnot(gt(nby, add(npy, padH)), live)));
+    nbx = select(hitP, nbx, sub(playerX, ballSz));
+    nvx = select(hitP, nvx, neg(nvx));
+    V nsc = sub(sc, hitP);
+
+    V out = or_(gt(nbx, courtW), lt(nbx, zero));
+
+    // Only lanes that were still in a rally take the new state
+    store(&b.ballX[i],   select(live, bx, nbx));
+    store(&b.ballY[i],   select(live, by, nby));
+    store(&b.ballVX[i],  select(live, vx, nvx));
+    store(&b.ballVY[i],  select(live, vy, nvy));
+    store(&b.cpuY[i],    select(live, cy, ncy));
+    store(&b.playerY[i], select(live, py, npy));
+    store(&b.score[i],   nsc);
+    store(&b.alive[i],   andnot(out, live));
+  }
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// N Pong games in structure-of-arrays form, stepped together with the
+// widest SIMD the build targets (AVX2, SSE4.1, WASM SIMD128, else scalar).
+// Each tick applies the autopilot player, then pongPhysicsTick() semantics
+// with masked, branch-free collision and scoring. Finished games freeze.
+struct PongBatch {
+  int count = 0;    // games in use
+  int padded = 0;   // count rounded up to the lane width
+
+  std::vector<int32_t> ballX, ballY, ballVX, ballVY;
+  std::vector<int32_t> cpuY, playerY;
+  std::vector<int32_t> score;
+  std::vector<int32_t> alive;   // -1 while the rally is running, 0 after a miss
+
+  // Court reset + serve, vy picked from seed like serveBall()
+  void reset(int n, uint32_t seed);
+};
+
+// Lane width of the compiled kernel and a short name for reports
+int         pongBatchLanes();
+const char* pongBatchIsa();
+
+// Advances games [first, last) by one tick; range bounds must be lane-aligned
+void pongBatchTick(PongBatch& b, int first, int last);
+
+// Scalar autopilot shared with the reference check: chase the ball centre
+// using the same limits stepPong() applies to button movement.
+int pongAutopilotY(int playerY, int ballY);
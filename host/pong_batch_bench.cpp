@@ -0,0 +1,96 @@
+// Batched Pong: bit-exact check against the scalar pongPhysicsTick(), then
+// rallies/second for 1..hardware_concurrency threads.
+//
+//   pong_batch_bench [games] [max_ticks]
+
+#include "pong_batch.h"
+#include "Pong.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace {
+
+  // Steps every game with the scalar code and compares all state each tick
+  bool verify(int games, int ticks) {
+    PongBatch b;
+    b.reset(games, 0xC0FFEEu);
+
+    std::vector<PongState> ref(games);
+    std::vector<bool> live(games, true);
+    for (int i = 0; i < games; ++i) {
+      resetPongCourt(ref[i]);
+      ref[i].ball.vx = -1;
+      ref[i].ball.vy = b.ballVY[i];
+      ref[i].gameActive = true;
+    }
+
+    for (int t = 0; t < ticks; ++t) {
+      pongBatchTick(b, 0, b.padded);
+      for (int i = 0; i < games; ++i) {
+        if (!live[i]) continue;
+        PongState& p = ref[i];
+        p.player.y = pongAutopilotY(p.player.y, p.ball.y);
+        live[i] = pongPhysicsTick(p);
+        bool same = p.ball.x == b.ballX[i] && p.ball.y == b.ballY[i] &&
+                    p.ball.vx == b.ballVX[i] && p.ball.vy == b.ballVY[i] &&
+                    p.cpu.y == b.cpuY[i] && p.player.y == b.playerY[i] &&
+                    p.playerScore == b.score[i] && live[i] == (b.alive[i] != 0);
+        if (!same) {
+          std::printf("MISMATCH game %d tick %d: ref ball(%d,%d v%d,%d) cpu %d player %d score %d | "
+                      "batch ball(%d,%d v%d,%d) cpu %d player %d score %d\n",
+                      i, t, p.ball.x, p.ball.y, p.ball.vx, p.ball.vy, p.cpu.y, p.player.y, p.playerScore,
+                      b.ballX[i], b.ballY[i], b.ballVX[i], b.ballVY[i], b.cpuY[i], b.playerY[i], b.score[i]);
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  // Runs all games to completion (or max_ticks) split across threads
+  double rallyRate(int games, int ticks, int threads, long long& rallies) {
+    PongBatch b;
+    b.reset(games, 0xBEEFu);
+    const int lanes = pongBatchLanes();
+    const int chunk = (b.padded / lanes + threads - 1) / threads * lanes;
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) {
+      int first = std::min(b.padded, t * chunk);
+      int last  = std::min(b.padded, first + chunk);
+      pool.emplace_back([&b, first, last, ticks] {
+        for (int k = 0; k < ticks; ++k) pongBatchTick(b, first, last);
+      });
+    }
+    for (auto& th : pool) th.join();
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    rallies = 0;
+    for (int i = 0; i < games; ++i) rallies += b.score[i];
+    return rallies / secs;
+  }
+
+} // anon
+
+int main(int argc, char** argv) {
+  int games = argc > 1 ? std::atoi(argv[1]) : 1 << 16;
+  int ticks = argc > 2 ? std::atoi(argv[2]) : 4000;
+
+  std::printf("kernel          %s (%d lanes)\n", pongBatchIsa(), pongBatchLanes());
+  if (!verify(std::min(games, 4096), ticks)) return 1;
+  std::printf("reference check OK (bit-exact vs pongPhysicsTick)\n");
+
+  int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+  for (int t = 1; ; t = std::min(t * 2, maxThreads)) {
+    long long rallies = 0;
+    double rate = rallyRate(games, ticks, t, rallies);
+    std::printf("threads %-3d     %.3g rallies/s (%lld rallies)\n", t, rate, rallies);
+    if (t == maxThreads) break;
+  }
+  return 0;
+}
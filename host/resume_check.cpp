@@ -0,0 +1,172 @@
+// Suspend/resume round trip: each sample boots a session, picks Snake or
+// Pong from the menu, lets the baseline agent play a while, then leaves
+// with the two-button hold. Once the snapshot is committed the "power" goes:
+// a fresh session starts on the committed storage alone. It must come up
+// IN_GAME with the same snapshot it was left with, get to a drawn game
+// frame within RESUME_BUDGET_MS, and keep playing.
+//
+// Times are the session's virtual clock from power-on, the same Millis()
+// that FrameDiag::firstPlayMs reports (and logs over Serial) on the device.
+// Besides the frame pacing the clock is charged a device model: I2C at
+// 400 kHz for every frame sent to the panel, and INIT_US for bus, panel and
+// EEPROM setup (the snapshot is read from EEPROM's RAM copy, so that is
+// in it). The boot ROM before setup() is not modelled; compare the logged
+// device figure. The cold-boot column is the same path without a snapshot
+// (boot animation, menu, Get Ready).
+//
+//   bloop_resume [samples per game]
+
+#include "agent.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+namespace {
+
+  constexpr uint64_t RESUME_BUDGET_MS = 300;
+  constexpr uint64_t COMMIT_WAIT_MS   = 15000;   // leaving to the snapshot being committed
+  constexpr uint32_t INIT_US          = 5000;    // Wire, panel init commands, EEPROM.begin (estimate)
+  constexpr uint32_t BUS_US_PER_BYTE  = 23;      // 9 bits per byte at 400 kHz, rounded up
+
+  struct Session {
+    Platform::Device::Impl impl;
+    Platform::Device dev{&impl};
+    GameContext ctx{dev};
+
+    explicit Session(uint32_t seed) {
+      impl.rng = seed | 1u;
+      impl.costs.initUs = INIT_US;
+      impl.costs.busUsPerByte = BUS_US_PER_BYTE;
+    }
+
+    // Power-on: what Init() and the boot path do, timed on the host CPU
+    double powerOn() {
+      auto t0 = std::chrono::steady_clock::now();
+      dev.Init();
+      initGameManager(ctx);
+      return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+    }
+
+    void frame(bool a, bool b) {
+      impl.buttons[0] = a;
+      impl.buttons[1] = b;
+      runGameLoop(ctx);
+    }
+
+    // Only what a commit wrote survives the power cut
+    void restoreStorage(const Platform::Device::Impl& from) {
+      std::memcpy(impl.store, from.store, sizeof(impl.store));
+      impl.storeCount = from.storeCount;
+      std::memcpy(impl.snapshot, from.snapshot, sizeof(impl.snapshot));
+      impl.snapshotLen = from.snapshotLen;
+      impl.hasSave = true;
+    }
+  };
+
+  struct Stats {
+    int samples = 0, resumed = 0, failed = 0, skipped = 0;
+    int bytesMax = 0;
+    long long bytesSum = 0;
+    uint64_t resumeMaxMs = 0, coldMaxMs = 0;
+    double resumeHostUsMax = 0;
+  };
+
+  // One round trip; false on a failed resume (skipped: the game ended
+  // before it could be left)
+  bool sample(GameID game, uint32_t seed, Stats& st) {
+    std::unique_ptr<Session> a(new Session(seed));
+    a->powerOn();
+    while (a->ctx.sys.Running() || a->ctx.state != SysState::MENU) a->frame(false, false);
+
+    // Down the menu to the game (past the debounce), then pick it
+    for (int f = 0; f < 15; ++f) a->frame(false, false);
+    for (int i = 0; i < static_cast<int>(game); ++i) {
+      for (int f = 0; f < 3; ++f) a->frame(false, true);
+      for (int f = 0; f < 15; ++f) a->frame(false, false);
+    }
+    for (int f = 0; f < 3; ++f) a->frame(true, false);
+    if (a->ctx.activeGame != game) { st.failed++; return false; }
+    std::unique_ptr<Agent> agent = makeBaselineAgent(game, seed);
+    uint32_t r = seed * 2654435761u + 1u;
+    r ^= r << 13; r ^= r >> 17; r ^= r << 5;
+    int frames = 100 + static_cast<int>(r % 1500);
+    for (int f = 0; f < frames || a->ctx.diag.firstPlayMs == FrameDiag::NOT_YET; ++f) {
+      if (a->ctx.state != SysState::IN_GAME && a->ctx.state != SysState::MENU_OUT) { st.skipped++; return true; }
+      InputState in;
+      if (a->ctx.state == SysState::IN_GAME) {
+        Observation obs{game, a->ctx.games.Get<SnakeState>(), a->ctx.games.Get<BigSnakeState>(), a->ctx.games.Get<PongState>(),
+                        a->impl.fb, a->impl.now, a->ctx.currentScore};
+        in = agent->act(obs);
+      }
+      a->frame(in.buttonA, in.buttonB);
+    }
+    uint64_t coldMs = a->ctx.diag.firstPlayMs;
+
+    // The hold pauses the game, so the state now is the state it is left in
+    uint8_t before[Platform::SNAPSHOT_BYTES];
+    int n = writeSnapshot(a->ctx, before, sizeof(before));
+    while (a->ctx.state == SysState::IN_GAME) a->frame(true, true);
+    uint64_t left = a->impl.now;
+    while ((a->ctx.sys.Running() || a->impl.storeDirty) && a->impl.now - left < COMMIT_WAIT_MS) a->frame(false, false);
+
+    st.samples++;
+    bool ok = n > 0 && !a->impl.storeDirty && a->impl.snapshotLen == n &&
+              std::memcmp(a->impl.snapshot, before, static_cast<size_t>(n)) == 0;
+
+    // Power cut; a new device on the same storage
+    std::unique_ptr<Session> b(new Session(seed ^ 0x5bd1e995u));
+    b->restoreStorage(a->impl);
+    double hostUs = b->powerOn();
+    uint8_t after[Platform::SNAPSHOT_BYTES];
+    ok = ok && b->ctx.state == SysState::IN_GAME && b->ctx.diag.resumed &&
+         writeSnapshot(b->ctx, after, sizeof(after)) == n && std::memcmp(after, before, static_cast<size_t>(n)) == 0;
+    for (int f = 0; ok && b->ctx.diag.firstPlayMs == FrameDiag::NOT_YET && f < 100; ++f) b->frame(false, false);
+    uint64_t resumeMs = b->ctx.diag.firstPlayMs;
+    ok = ok && resumeMs <= RESUME_BUDGET_MS;
+
+    // And it plays on from there
+    std::unique_ptr<Agent> again = makeBaselineAgent(game, seed);
+    for (int f = 0; ok && f < 600 && b->ctx.state == SysState::IN_GAME; ++f) {
+      Observation obs{game, b->ctx.games.Get<SnakeState>(), b->ctx.games.Get<BigSnakeState>(), b->ctx.games.Get<PongState>(),
+                      b->impl.fb, b->impl.now, b->ctx.currentScore};
+      InputState in = again->act(obs);
+      b->frame(in.buttonA, in.buttonB);
+    }
+
+    if (!ok) { st.failed++; return false; }
+    st.resumed++;
+    st.bytesMax = std::max(st.bytesMax, n);
+    st.bytesSum += n;
+    st.resumeMaxMs = std::max(st.resumeMaxMs, resumeMs);
+    st.coldMaxMs = std::max(st.coldMaxMs, coldMs);
+    st.resumeHostUsMax = std::max(st.resumeHostUsMax, hostUs);
+    return true;
+  }
+
+} // anon
+
+int main(int argc, char** argv) {
+  int samples = argc > 1 ? std::atoi(argv[1]) : 200;
+
+  std::printf("game     samples  resumed  failed  skipped  snapshot B (mean/max)  power-on to play ms  cold boot ms  host us\n");
+  bool ok = true;
+  for (GameID game : { GameID::SNAKE, GameID::PONG }) {
+    Stats st;
+    for (int i = 0; i < samples; ++i) {
+      if (!sample(game, 1u + static_cast<uint32_t>(i) * 7919u, st) && st.failed == 1)
+        std::printf("  seed %u failed\n", 1u + static_cast<uint32_t>(i) * 7919u);
+    }
+    ok = ok && st.failed == 0 && st.resumed > 0;
+    std::printf("%-8s %7d  %7d  %6d  %7d  %10.1f / %3d  %19llu  %12llu  %7.1f\n",
+                game == GameID::SNAKE ? "snake" : "pong", st.samples + st.skipped, st.resumed, st.failed, st.skipped,
+                st.resumed ? double(st.bytesSum) / st.resumed : 0.0, st.bytesMax,
+                static_cast<unsigned long long>(st.resumeMaxMs), static_cast<unsigned long long>(st.coldMaxMs),
+                st.resumeHostUsMax);
+  }
+  std::printf("\nbudget %llu ms from power-on to play: %s\n",
+              static_cast<unsigned long long>(RESUME_BUDGET_MS), ok ? "OK" : "FAILED");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+// Headless session runner: simulates many independent BLOOP consoles in one
+// process, spread across all cores. Each session owns its Device::Impl and
+// GameContext, so no state is shared between threads.
+//
+//   bloop_runner [sessions] [frames_per_session] [threads]
+
+#include "GameManager.h"
+#include "platform_host.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+  struct SessionResult {
+    int games = 0;
+    long long scoreSum = 0;
+    Platform::PresentStats presents;
+    int flowSlots = 0, flowBytes = 0;
+    uint32_t flowFailures = 0;
+    TaskScheduler::Stats tasks;
+    uint32_t commits = 0;
+  };
+
+  // Random button presses with short holds, menu picks included
+  SessionResult runSession(uint32_t seed, int frames) {
+    Platform::Device::Impl impl;
+    impl.rng = seed | 1u;
+    Platform::Device dev(&impl);
+    std::unique_ptr<GameContext> ctx(new GameContext(dev));
+
+    dev.Init();
+    initGameManager(*ctx);
+
+    uint32_t input = seed * 2654435761u + 1u;
+    SessionResult r;
+    SysState prev = ctx->state;
+    for (int f = 0; f < frames; ++f) {
+      input ^= input << 13; input ^= input >> 17; input ^= input << 5;
+      impl.buttons[0] = (input & 0x7) == 0;
+      impl.buttons[1] = (input & 0x38) == 0;
+
+      runGameLoop(*ctx);
+
+      if (ctx->state == SysState::GAME_OVER && prev != SysState::GAME_OVER) {
+        r.games++;
+        r.scoreSum += ctx->gameOverScore;
+      }
+      prev = ctx->state;
+    }
+    r.presents = dev.Presents();
+    r.flowSlots = ctx->flows.HighWater();
+    r.flowBytes = ctx->flows.Largest();
+    r.flowFailures = ctx->flows.Failures();
+    r.tasks = ctx->tasks.GetStats();
+    r.commits = impl.commits;
+    return r;
+  }
+
+} // anon
+
+int main(int argc, char** argv) {
+  int sessions = argc > 1 ? std::atoi(argv[1]) : 1000;
+  int frames   = argc > 2 ? std::atoi(argv[2]) : 5000;
+  int threads  = argc > 3 ? std::atoi(argv[3]) : static_cast<int>(std::thread::hardware_concurrency());
+  if (threads < 1) threads = 1;
+
+  std::vector<SessionResult> results(sessions);
+  std::atomic<int> next{0};
+
+  auto t0 = std::chrono::steady_clock::now();
+  std::vector<std::thread> pool;
+  for (int t = 0; t < threads; ++t) {
+    pool.emplace_back([&] {
+      for (int i = next++; i < sessions; i = next++) {
+        results[i] = runSession(static_cast<uint32_t>(i) + 1u, frames);
+      }
+    });
+  }
+  for (auto& th : pool) th.join();
+  double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+  long long games = 0, scores = 0, sent = 0, skipped = 0, flowFailures = 0;
+  int flowSlots = 0, flowBytes = 0;
+  long long taskRuns = 0, taskDeferred = 0, taskForced = 0, commits = 0;
+  for (const auto& r : results) {
+    games += r.games; scores += r.scoreSum;
+    sent += r.presents.sent; skipped += r.presents.skipped;
+    flowSlots = std::max(flowSlots, r.flowSlots);
+    flowBytes = std::max(flowBytes, r.flowBytes);
+    flowFailures += r.flowFailures;
+    taskRuns += r.tasks.runs; taskDeferred += r.tasks.deferred; taskForced += r.tasks.forced;
+    commits += r.commits;
+  }
+
+  std::printf("sessions        %d (%d threads)\n", sessions, threads);
+  std::printf("frames          %lld\n", static_cast<long long>(sessions) * frames);
+  std::printf("games finished  %lld (mean score %.2f)\n", games, games ? double(scores) / games : 0.0);
+  std::printf("presents        %lld sent, %lld skipped unchanged (%.0f%%)\n", sent, skipped,
+              sent + skipped ? 100.0 * skipped / (sent + skipped) : 0.0);
+  std::printf("flow arena      %d of %d slots, largest frame %d of %d B, %lld failed\n",
+              flowSlots, FlowArena::SLOTS, flowBytes, FlowArena::SLOT_BYTES, flowFailures);
+  std::printf("game arena      %zu B, %zu B less than separate states (", GameStates::BYTES,
+              GameStates::SUM - GameStates::BYTES);
+  for (const auto& g : GameStates::REPORT)
+    std::printf("%s%s %zu of %zu B", &g == GameStates::REPORT ? "" : ", ", g.name, g.bytes, g.budget);
+  std::printf(")\n");
+  std::printf("background      %lld task runs (%lld storage commits), %lld deferred, %lld forced late\n",
+              taskRuns, commits, taskDeferred, taskForced);
+  std::printf("wall time       %.2f s (%.0f frames/s)\n", secs, double(sessions) * frames / secs);
+  return 0;
+}
@@ -0,0 +1,129 @@
+// Parallel self-play tournament: plays many Snake/Pong episodes per
+// difficulty parameter set with the baseline agents and prints score
+// distributions, turning difficulty tuning into a batch job.
+//
+//   bloop_selfplay [--game snake|pong|both] [--episodes N] [--threads N]
+//                  [--max-frames N] [--snake-delay a,b,..]
+//                  [--pong-speed a,b,..] [--pong-tick a,b,..]
+
+#include "agent.h"
+#include "work_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+  constexpr int EPISODES_PER_TASK = 64;
+
+  struct ParamSet {
+    GameID game;
+    TuningParams params;
+    std::vector<EpisodeResult> results;
+  };
+
+  std::vector<int> parseList(const char* s) {
+    std::vector<int> out;
+    while (*s) {
+      out.push_back(std::atoi(s));
+      const char* comma = std::strchr(s, ',');
+      if (!comma) break;
+      s = comma + 1;
+    }
+    return out;
+  }
+
+  void report(const ParamSet& ps) {
+    std::vector<int> scores;
+    long long sum = 0, frames = 0;
+    int timeouts = 0;
+    for (const auto& r : ps.results) {
+      scores.push_back(r.score);
+      sum += r.score;
+      frames += r.frames;
+      timeouts += r.timedOut;
+    }
+    std::sort(scores.begin(), scores.end());
+    auto pct = [&](double p) { return scores[std::min(scores.size() - 1, size_t(p * scores.size()))]; };
+
+    if (ps.game == GameID::SNAKE)
+      std::printf("snake delay=%-4u ", ps.params.snakeMoveDelayMs);
+    else
+      std::printf("pong  speed=%d tick=%-3u ", ps.params.pongPaddleSpeed, ps.params.pongTickMs);
+    std::printf(" mean %6.2f  p50 %4d  p90 %4d  p99 %4d  max %4d  frames/ep %6.0f  timeouts %d\n",
+                double(sum) / scores.size(), pct(0.5), pct(0.9), pct(0.99), scores.back(),
+                double(frames) / scores.size(), timeouts);
+  }
+
+} // anon
+
+int main(int argc, char** argv) {
+  std::string game = "both";
+  int  episodes  = 2000;
+  int  threads   = static_cast<int>(std::thread::hardware_concurrency());
+  long maxFrames = 20000;
+  std::vector<int> snakeDelay = { int(SnakeState::MOVE_DELAY_MS_BASE) };
+  std::vector<int> pongSpeed  = { PongState::PADDLE_SPEED_BASE };
+  std::vector<int> pongTick   = { int(PongState::TICK_MS_BASE) };
+
+  for (int i = 1; i + 1 < argc; i += 2) {
+    const char* k = argv[i];
+    const char* v = argv[i + 1];
+    if      (!std::strcmp(k, "--game"))        game = v;
+    else if (!std::strcmp(k, "--episodes"))    episodes = std::atoi(v);
+    else if (!std::strcmp(k, "--threads"))     threads = std::atoi(v);
+    else if (!std::strcmp(k, "--max-frames"))  maxFrames = std::atol(v);
+    else if (!std::strcmp(k, "--snake-delay")) snakeDelay = parseList(v);
+    else if (!std::strcmp(k, "--pong-speed"))  pongSpeed = parseList(v);
+    else if (!std::strcmp(k, "--pong-tick"))   pongTick = parseList(v);
+    else { std::fprintf(stderr, "unknown option %s\n", k); return 2; }
+  }
+  if (episodes < 1) episodes = 1;
+
+  std::vector<ParamSet> sets;
+  if (game == "snake" || game == "both") {
+    for (int d : snakeDelay) {
+      ParamSet ps{GameID::SNAKE, {}, {}};
+      ps.params.snakeMoveDelayMs = static_cast<unsigned>(d);
+      sets.push_back(ps);
+    }
+  }
+  if (game == "pong" || game == "both") {
+    for (int sp : pongSpeed) for (int t : pongTick) {
+      ParamSet ps{GameID::PONG, {}, {}};
+      ps.params.pongPaddleSpeed = sp;
+      ps.params.pongTickMs = static_cast<unsigned>(t);
+      sets.push_back(ps);
+    }
+  }
+
+  WorkPool pool(threads);
+  for (size_t s = 0; s < sets.size(); ++s) {
+    sets[s].results.resize(episodes);
+    for (int first = 0; first < episodes; first += EPISODES_PER_TASK) {
+      int last = std::min(episodes, first + EPISODES_PER_TASK);
+      ParamSet* ps = &sets[s];
+      pool.submit([ps, s, first, last, maxFrames] {
+        for (int e = first; e < last; ++e) {
+          uint32_t seed = static_cast<uint32_t>(s * 1000003u + e * 7919u + 1u);
+          auto agent = makeBaselineAgent(ps->game, seed);
+          ps->results[e] = runEpisode(ps->game, ps->params, *agent, seed, maxFrames);
+        }
+      });
+    }
+  }
+
+  auto t0 = std::chrono::steady_clock::now();
+  pool.run();
+  double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+  for (const auto& ps : sets) report(ps);
+  long long total = static_cast<long long>(sets.size()) * episodes;
+  std::printf("%lld episodes on %zu threads in %.2f s (%.0f episodes/s)\n",
+              total, pool.threads(), secs, total / secs);
+  return 0;
+}
@@ -0,0 +1,126 @@
+// Big Snake frame cost against world size: the same session (camera on
+// the head, world in a 2-bit grid, only the viewport rasterized) on worlds
+// from screen size up to the largest, played by a bot that heads for the
+// latest food and steers clear of its own body. Every in-game frame is timed
+// through runGameLoop(); mean, p99 and p99.9 should stay flat as the world
+// grows. The start (world reset and food placement) happens once per game
+// and is reported apart.
+//
+//   snake_world_bench [frames]
+
+#include "GameManager.h"
+#include "platform_host.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+namespace {
+
+  struct Size { int cols, rows; };
+
+  // Greedy towards s.food, taking the first of (towards food, straight,
+  // clockwise, counter-clockwise) whose next cell is free
+  struct Bot {
+    bool pressed = false;
+
+    static bool freeAhead(const BigSnakeState& s, int dir) {
+      static const int DX[] = { 1, 0, -1, 0 }, DY[] = { 0, 1, 0, -1 };
+      SnakeState::Pt h = s.Head();
+      int nx = (h.x + DX[dir] + s.worldCols) % s.worldCols;
+      int ny = (h.y + DY[dir] + s.worldRows) % s.worldRows;
+      return s.world.Get(nx, ny) != SnakeState::BODY;
+    }
+
+    void act(const BigSnakeState& s, bool& a, bool& b) {
+      a = b = false;
+      if (pressed) { pressed = false; return; }
+      SnakeState::Pt h = s.Head();
+      int want = s.dir;
+      if      (s.food.x > h.x) want = SnakeState::RIGHT;
+      else if (s.food.x < h.x) want = SnakeState::LEFT;
+      else if (s.food.y > h.y) want = SnakeState::DOWN;
+      else if (s.food.y < h.y) want = SnakeState::UP;
+      if ((want - s.dir + 4) % 4 == 2) want = (s.dir + 1) % 4;   // no reversing
+      const int order[] = { want, s.dir, (s.dir + 1) % 4, (s.dir + 3) % 4 };
+      for (int d : order) {
+        if (!freeAhead(s, d)) continue;
+        int turn = (d - s.dir + 4) % 4;
+        a = turn == 3;
+        b = turn == 1;
+        break;
+      }
+      pressed = a || b;
+    }
+  };
+
+  struct Result {
+    double meanNs = 0, p99Ns = 0, p999Ns = 0, startNs = 0;
+    long frames = 0;
+    int games = 0, longest = 0;
+  };
+
+  Result run(Size size, int frames) {
+    Platform::Device::Impl impl;
+    Platform::Device dev(&impl);
+    std::unique_ptr<GameContext> ctx(new GameContext(dev));
+    dev.Init();
+    initGameManager(*ctx);
+
+    Bot bot;
+    std::vector<double> ns;
+    ns.reserve(frames);
+    double startSum = 0;
+    Result r;
+    for (int f = 0; f < frames; ++f) {
+      if (ctx->state != SysState::IN_GAME) {
+        ctx->sys = Flow();   // skip the boot / game-over flow
+        ctx->activeGame = GameID::BIG_SNAKE;
+        ctx->gameInited = false;
+        ctx->currentScore = 0;
+        ctx->exitReq = ctx->gameOver = false;
+        BigSnakeState& s = ctx->games.Emplace<BigSnakeState>();
+        s.worldCols = size.cols;
+        s.worldRows = size.rows;
+        ctx->state = SysState::IN_GAME;
+        auto t0 = std::chrono::steady_clock::now();
+        runGameLoop(*ctx);
+        startSum += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+        r.games++;
+        continue;
+      }
+      bot.act(ctx->games.As<BigSnakeState>(), impl.buttons[0], impl.buttons[1]);
+      auto t0 = std::chrono::steady_clock::now();
+      runGameLoop(*ctx);
+      double dt = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+      if (ctx->state == SysState::IN_GAME) ns.push_back(dt);
+      if (const BigSnakeState* s = ctx->games.Get<BigSnakeState>()) r.longest = std::max(r.longest, s->length);
+    }
+    if (ns.empty()) return r;
+    r.frames = static_cast<long>(ns.size());
+    for (double v : ns) r.meanNs += v;
+    r.meanNs /= ns.size();
+    std::sort(ns.begin(), ns.end());
+    r.p99Ns = ns[ns.size() * 99 / 100];
+    r.p999Ns = ns[ns.size() * 999 / 1000];
+    r.startNs = startSum / r.games;
+    return r;
+  }
+
+} // anon
+
+int main(int argc, char** argv) {
+  int frames = argc > 1 ? std::atoi(argv[1]) : 200000;
+  const Size sizes[] = {
+    { SnakeState::COLS, SnakeState::ROWS }, { 64, 48 }, { 128, 96 }, { SnakeState::BIG_COLS, SnakeState::BIG_ROWS },
+  };
+  std::printf("world    cells   frame mean      p99    p99.9    start   games  longest\n");
+  for (const Size& s : sizes) {
+    Result r = run(s, frames);
+    std::printf("%3dx%-3d %6d  %8.0f ns %6.0f ns %6.0f ns %6.0f ns  %5d  %5d\n",
+                s.cols, s.rows, s.cols * s.rows, r.meanNs, r.p99Ns, r.p999Ns, r.startNs, r.games, r.longest);
+  }
+  return 0;
+}
@@ -0,0 +1,124 @@
+// Sprite blits vs the FillRect/DrawText loops they replace: ns per object
+// for the Pong ball and paddle and the boot logo at random positions
+// (partly off-screen), per raster op. Then a Pong playfield frame both ways:
+// clear + court + FillRects, against XOR-erasing and redrawing the movers,
+// and a Snake playfield: every cell filled again, against the tile map
+// repainting only the cells that changed.
+//
+//   sprite_bench [iterations]
+
+#include "assets.h"
+#include "tilemap.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+  constexpr int W = Raster::WIDTH, H = Raster::HEIGHT, BAR = 16;
+
+  struct Pos { int x, y; };
+
+  std::vector<Pos> positions(int n, int w, int h) {
+    std::vector<Pos> v(n);
+    uint32_t r = 12345;
+    for (auto& p : v) {
+      r ^= r << 13; r ^= r >> 17; r ^= r << 5;
+      p.x = static_cast<int>(r % (W + w)) - w / 2;
+      p.y = static_cast<int>((r >> 8) % (H + h)) - h / 2;
+    }
+    return v;
+  }
+
+  template <typename F>
+  double nsPer(int n, F body) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i) body(i);
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / n;
+  }
+
+  uint8_t fb[Raster::BYTES];
+
+  void object(const char* name, const Raster::Sprite& s, int n, void (*classic)(int, int)) {
+    auto pos = positions(1024, s.w, s.h);
+    double ref = nsPer(n, [&](int i) { classic(pos[i & 1023].x, pos[i & 1023].y); });
+    double orNs  = nsPer(n, [&](int i) { Raster::DrawSprite(fb, pos[i & 1023].x, pos[i & 1023].y, s, Raster::Rop::OR); });
+    double andNs = nsPer(n, [&](int i) { Raster::DrawSprite(fb, pos[i & 1023].x, pos[i & 1023].y, s, Raster::Rop::AND_NOT); });
+    double xorNs = nsPer(n, [&](int i) { Raster::DrawSprite(fb, pos[i & 1023].x, pos[i & 1023].y, s, Raster::Rop::XOR); });
+    std::printf("%-7s %2dx%-2d  classic %6.1f ns   OR %6.1f   AND-NOT %6.1f   XOR %6.1f ns  (x%.1f)\n",
+                name, s.w, s.h, ref, orNs, andNs, xorNs, ref / orNs);
+  }
+
+  void court() {
+    for (int x = 0; x < W; x += 4) { Raster::FillRect(fb, x, BAR, 2, 1, true); Raster::FillRect(fb, x, H - 1, 2, 1, true); }
+    for (int y = BAR; y < H; y += 4) { Raster::FillRect(fb, 0, y, 1, 2, true); Raster::FillRect(fb, W - 1, y, 1, 2, true); }
+    for (int y = BAR; y < H; y += 4) Raster::SetPixel(fb, W / 2, y, true);
+  }
+
+  void movers(int f) {
+    int y = BAR + f % (H - BAR - 10);
+    Raster::DrawSprite(fb, 3, y, Assets::PADDLE, Raster::Rop::XOR);
+    Raster::DrawSprite(fb, W - 5, H - 10 - f % (H - BAR - 10), Assets::PADDLE, Raster::Rop::XOR);
+    Raster::DrawSprite(fb, (f * 3) % W, BAR + (f * 7) % (H - BAR - 2), Assets::BALL, Raster::Rop::XOR);
+  }
+
+  // 40-cell snake crawling through the 32x12 grid: head in, tail out
+  constexpr int SNAKE = 40;
+  Raster::TileMap<32, 12> tiles;
+
+  void snakeCells(int f) {
+    for (int i = 0; i < SNAKE; ++i) {
+      int c = (f + i) % (32 * 12);
+      Raster::FillRect(fb, c % 32 * 4, c / 32 * 4 + BAR, 4, 4, true);
+    }
+    Raster::FillRect(fb, 60, BAR + 20, 4, 4, true);
+  }
+
+  void snakeStep(int f) {
+    int tail = (f - 1) % (32 * 12), head = (f + SNAKE - 1) % (32 * 12);
+    tiles.Set(tail % 32, tail / 32, 0);
+    tiles.Set(head % 32, head / 32, 1);
+    tiles.Draw(fb);
+  }
+
+} // anon
+
+int main(int argc, char** argv) {
+  int n = argc > 1 ? std::atoi(argv[1]) : 2000000;
+
+  object("ball",   Assets::BALL,   n, [](int x, int y) { Raster::FillRect(fb, x, y, 2, 2, true); });
+  object("paddle", Assets::PADDLE, n, [](int x, int y) { Raster::FillRect(fb, x, y, 2, 10, true); });
+  object("logo",   Assets::LOGO,   n / 8, [](int x, int y) { Raster::DrawText(fb, x, y, "BLOOP", 2, true); });
+
+  int frames = n / 20;
+  double full = nsPer(frames, [](int f) {
+    Raster::FillRect(fb, 0, BAR, W, H - BAR, false);
+    court();
+    int y = BAR + f % (H - BAR - 10);
+    Raster::FillRect(fb, 3, y, 2, 10, true);
+    Raster::FillRect(fb, W - 5, H - 10 - f % (H - BAR - 10), 2, 10, true);
+    Raster::FillRect(fb, (f * 3) % W, BAR + (f * 7) % (H - BAR - 2), 2, 2, true);
+  });
+  Raster::FillRect(fb, 0, BAR, W, H - BAR, false);
+  court();
+  movers(0);
+  double xorNs = nsPer(frames, [](int f) { movers(f); movers(f + 1); });
+  std::printf("pong playfield  redraw %6.0f ns   XOR erase+draw %6.0f ns  (x%.1f)\n", full, xorNs, full / xorNs);
+
+  double redraw = nsPer(frames, [](int f) {
+    Raster::FillRect(fb, 0, BAR, W, H - BAR, false);
+    snakeCells(f);
+  });
+  tiles.Init(Assets::SNAKE_TILES, 0, BAR);
+  for (int i = 0; i < SNAKE; ++i) tiles.Set(i % 32, i / 32, 1);
+  tiles.Set(15, 5, 2);
+  tiles.Draw(fb);
+  double dirty = nsPer(frames, [](int f) { snakeStep(f + 1); });
+  std::printf("snake playfield redraw %6.0f ns   dirty tiles    %6.0f ns  (x%.1f)\n", redraw, dirty, redraw / dirty);
+
+  unsigned sum = 0;
+  for (uint8_t b : fb) sum += b;
+  std::printf("checksum %u\n", sum);
+  return 0;
+}
@@ -0,0 +1,67 @@
+// Frame-time trace of one headless session: built with BLOOP_TRACE=1, it
+// boots, goes through the menu and plays Snake then Pong with the baseline
+// agents, and writes the last BLOOP_TRACE_EVENTS scopes (runGameLoop, the
+// step and draw helpers, Present) as Chrome trace-event JSON. Open the file
+// in https://ui.perfetto.dev or chrome://tracing.
+//
+//   bloop_trace [out.json] [frames per game]
+
+#include "GameManager.h"
+#include "platform_host.h"
+#include "agent.h"
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+#if !BLOOP_TRACE
+  #error "build with -DBLOOP_TRACE=1 (make bloop_trace)"
+#endif
+
+namespace {
+
+  void toFile(const char* text, int n, void* user) {
+    std::fwrite(text, 1, static_cast<size_t>(n), static_cast<std::FILE*>(user));
+  }
+
+} // anon
+
+int main(int argc, char** argv) {
+  const char* path = argc > 1 ? argv[1] : "bloop_trace.json";
+  int frames = argc > 2 ? std::atoi(argv[2]) : 600;
+
+  Platform::Device::Impl impl;
+  Platform::Device dev(&impl);
+  std::unique_ptr<GameContext> ctx(new GameContext(dev));
+  dev.Init();
+  initGameManager(*ctx);
+
+  // Boot animation and menu, untouched
+  while (ctx->sys.Running() || ctx->state != SysState::MENU) runGameLoop(*ctx);
+
+  for (GameID game : { GameID::SNAKE, GameID::PONG }) {
+    std::unique_ptr<Agent> agent = makeBaselineAgent(game, 1u);
+    ctx->sys = Flow();
+    ctx->activeGame = game;
+    if (game == GameID::SNAKE) ctx->games.Emplace<SnakeState>();
+    else                       ctx->games.Emplace<PongState>();
+    ctx->gameInited = false;
+    ctx->currentScore = 0;
+    ctx->exitReq = ctx->gameOver = false;
+    ctx->state = SysState::IN_GAME;
+    for (int f = 0; f < frames && ctx->state == SysState::IN_GAME; ++f) {
+      Observation obs{game, ctx->games.Get<SnakeState>(), ctx->games.Get<BigSnakeState>(), ctx->games.Get<PongState>(),
+                      impl.fb, impl.now, ctx->currentScore};
+      InputState in = agent->act(obs);
+      impl.buttons[0] = in.buttonA;
+      impl.buttons[1] = in.buttonB;
+      runGameLoop(*ctx);
+    }
+  }
+
+  std::FILE* f = std::fopen(path, "w");
+  if (!f) { std::perror(path); return 1; }
+  Trace::WriteJson(toFile, f);
+  std::fclose(f);
+  std::printf("%u events (last %u kept) -> %s\n", Trace::ring().head, Trace::ring().Count(), path);
+  return 0;
+}
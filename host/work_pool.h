@@ -0,0 +1,61 @@
+#pragma once
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Minimal work-stealing pool: each worker owns a deque, pops from its back
+// and steals from the front of the others when it runs dry. Tasks are coarse
+// (a batch of episodes), so a mutex per deque is plenty.
+class WorkPool {
+public:
+  using Task = std::function<void()>;
+
+  explicit WorkPool(int threads) : queues_(threads > 0 ? threads : 1) {}
+
+  // Round-robin initial placement; call before run()
+  void submit(Task t) {
+    Queue& q = queues_[next_++ % queues_.size()];
+    std::lock_guard<std::mutex> lock(q.m);
+    q.tasks.push_back(std::move(t));
+  }
+
+  // Runs every submitted task and returns when all are done
+  void run() {
+    std::vector<std::thread> workers;
+    for (size_t w = 0; w < queues_.size(); ++w) {
+      workers.emplace_back([this, w] {
+        Task t;
+        while (take(w, t)) t();
+      });
+    }
+    for (auto& th : workers) th.join();
+  }
+
+  size_t threads() const { return queues_.size(); }
+
+private:
+  struct Queue {
+    std::mutex m;
+    std::deque<Task> tasks;
+  };
+
+  bool take(size_t self, Task& out) {
+    {
+      Queue& q = queues_[self];
+      std::lock_guard<std::mutex> lock(q.m);
+      if (!q.tasks.empty()) { out = std::move(q.tasks.back()); q.tasks.pop_back(); return true; }
+    }
+    for (size_t i = 1; i < queues_.size(); ++i) {
+      Queue& q = queues_[(self + i) % queues_.size()];
+      std::lock_guard<std::mutex> lock(q.m);
+      if (!q.tasks.empty()) { out = std::move(q.tasks.front()); q.tasks.pop_front(); return true; }
+    }
+    return false;  // tasks are never added while running, so empty means done
+  }
+
+  std::vector<Queue> queues_;
+  size_t next_ = 0;
+};
@@ -1,6 +1,8 @@
 #include <emscripten.h>
 #include <emscripten/html5.h>
+#include <cstdint>
 #include "../bloop/bloop_entry.h"
+#include "../bloop/trace.h"
 
 // Global game loop function
 void main_loop() {
@@ -18,38 +20,85 @@ int main() {
 
 // JavaScript interface functions
 extern "C" {
+  // Hands the page the module's 128x64 RGBA image and the rectangle that
+  // changed since the last present
   EMSCRIPTEN_KEEPALIVE
-  void js_draw_pixel(int x, int y, int color) {
+  void js_display(const uint32_t* rgba, int x, int y, int w, int h) {
     EM_ASM({
-      drawPixel($0, $1, $2);
-    }, x, y, color);
+      updateDisplay(HEAPU8.buffer, $0, $1, $2, $3, $4);
+    }, rgba, x, y, w, h);
   }
   
+  // Hands the worker a writer that appends button edges to the InputRing at
+  // $0 (layout in bloop/platform_web.h), plus a reader for its latency stats
+  // and the PresentStats at $1
   EMSCRIPTEN_KEEPALIVE
-  void js_display() {
+  void js_input_attach(void* ring, const void* presents) {
     EM_ASM({
-      updateDisplay();
-    });
+      var h = $0 >> 2;
+      attachInput(function(timeMs, button, down) {
+        var head = HEAPU32[h], tail = HEAPU32[h + 1];
+        if (((head - tail) >>> 0) >= 32) { HEAPU32[h + 1] = tail + 1; HEAPU32[h + 2]++; }
+        var e = $0 + 32 + (head & 31) * 16;
+        HEAPF64[e >> 3] = timeMs;
+        HEAP32[(e >> 2) + 2] = button;
+        HEAP32[(e >> 2) + 3] = down;
+        HEAPU32[h] = head + 1;
+      }, function() {
+        var n = HEAPU32[h + 3];
+        return {
+          edges: n,
+          dropped: HEAPU32[h + 2],
+          meanMs: n ? HEAPF64[($0 + 16) >> 3] / n : 0,
+          maxMs: HEAPF64[($0 + 24) >> 3],
+          presentsSent: HEAPU32[$1 >> 2],
+          presentsSkipped: HEAPU32[($1 >> 2) + 1],
+        };
+      });
+    }, ring, presents);
   }
   
+  // Copies the save blob preloaded by index.html into WASM memory (once, at Init)
   EMSCRIPTEN_KEEPALIVE
-  void js_clear_display() {
-    EM_ASM({
-      clearDisplay();
-    });
+  int js_save_load(uint8_t* dst, int capacity) {
+    return EM_ASM_INT({
+      var blob = Module.bloopSave;
+      if (!blob || blob.length > $1) return 0;
+      HEAPU8.set(blob, $0);
+      return blob.length;
+    }, dst, capacity);
   }
-  
+
+  // Asks the page to persist the blob lazily; the bytes are read at write time
   EMSCRIPTEN_KEEPALIVE
-  int js_button_pressed(int pin) {
-    return EM_ASM_INT({
-      return isButtonPressed($0);
-    }, pin);
+  void js_save_schedule(const uint8_t* src, int size) {
+    EM_ASM({
+      scheduleSave(function() { return HEAPU8.slice($0, $0 + $1); });
+    }, src, size);
   }
-  
+
   EMSCRIPTEN_KEEPALIVE
   double js_now() {
     return EM_ASM_DOUBLE({
       return performance.now();
     });
   }
+
+#if BLOOP_TRACE
+  // Serialises the trace ring and posts it to the page, which downloads it
+  // (bloopTrace() in the console). TRACE=1 builds only.
+  EMSCRIPTEN_KEEPALIVE
+  void js_trace_dump() {
+    static char json[BLOOP_TRACE_EVENTS * 112 + 64];
+    struct Out { int len; } out = { 0 };
+    Trace::WriteJson([](const char* text, int n, void* user) {
+      Out& o = *static_cast<Out*>(user);
+      if (o.len + n > static_cast<int>(sizeof(json))) return;
+      for (int i = 0; i < n; ++i) json[o.len++] = text[i];
+    }, &out);
+    EM_ASM({
+      postMessage({ type: 'trace', json: UTF8ToString($0, $1) });
+    }, json, out.len);
+  }
+#endif
 }
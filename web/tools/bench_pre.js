@@ -0,0 +1,4 @@
+// Page bridges for running benchmarks under Node: presents go nowhere
+globalThis.updateDisplay   = () => {};
+globalThis.attachInput     = () => {};
+globalThis.scheduleSave    = () => {};
@@ -0,0 +1,55 @@
+// Startup report for the web build: bundle sizes and time-to-first-frame.
+// Runs bloop.js under Node with the page's JS bridges stubbed out and exits
+// non-zero when any MAX_* budget from the Makefile is exceeded.
+const fs   = require('fs');
+const path = require('path');
+const zlib = require('zlib');
+
+const dir = path.resolve(__dirname, '..');
+const budgets = {
+  wasm: Number(process.env.MAX_WASM_BYTES || Infinity),
+  js:   Number(process.env.MAX_JS_BYTES   || Infinity),
+  ttff: Number(process.env.MAX_TTFF_MS    || Infinity),
+};
+
+function sizes(file) {
+  const buf = fs.readFileSync(path.join(dir, file));
+  return { raw: buf.length, gz: zlib.gzipSync(buf, { level: 9 }).length };
+}
+
+const wasm = sizes('bloop.wasm');
+const js   = sizes('bloop.js');
+console.log(`bloop.wasm  ${wasm.raw} bytes (${wasm.gz} gzip)`);
+console.log(`bloop.js    ${js.raw} bytes (${js.gz} gzip)`);
+
+let failed = false;
+function check(name, value, max, unit) {
+  if (value > max) {
+    console.error(`FAIL: ${name} ${value}${unit} exceeds budget ${max}${unit}`);
+    failed = true;
+  }
+}
+check('bloop.wasm', wasm.raw, budgets.wasm, ' bytes');
+check('bloop.js',   js.raw,   budgets.js,   ' bytes');
+
+// Page bridges called from EM_ASM; only the first present matters here
+const t0 = performance.now();
+globalThis.attachInput = () => {};
+globalThis.scheduleSave = () => {};
+globalThis.updateDisplay = () => {
+  const ttff = performance.now() - t0;
+  console.log(`time-to-first-frame  ${ttff.toFixed(1)} ms`);
+  check('time-to-first-frame', Math.round(ttff), budgets.ttff, ' ms');
+  process.exit(failed ? 1 : 0);
+};
+globalThis.Module = {
+  locateFile: (f) => path.join(dir, f),
+  preRun: [() => { globalThis.Module.bloopSave = null; }],
+};
+
+setTimeout(() => {
+  console.error('FAIL: no frame presented within 5 s');
+  process.exit(1);
+}, 5000);
+
+require(path.join(dir, 'bloop.js'));
@@ -0,0 +1,255 @@
+// Worker protocol check: runs worker.js in a Node vm context standing in for
+// the dedicated worker, with postMessage, OffscreenCanvas and ImageData
+// stubbed. bloop.js is replaced by a stand-in module that drives the same
+// bridges web/main.cpp calls (attachInput with the InputRing writer,
+// updateDisplay, scheduleSave, Module.bloopSave), so no emcc is needed.
+//
+// Checked, as the page (index.html) would use it:
+//   - input delivery: edges arrive in order, rebased to the worker clock,
+//     through the postMessage fallback and through the SharedArrayBuffer
+//     queue, including a page that laps the queue
+//   - frame hand-off: putImageData of the dirty rectangle on a transferred
+//     OffscreenCanvas, or a transferred RGBA 'frame' message without one;
+//     'first-frame' is posted once
+//   - save round-trip: the blob the worker posts, fed back into a new
+//     worker's 'init', is what the module loads
+//
+// The deployed GitHub Pages site is not cross-origin isolated (Pages cannot
+// send COOP/COEP headers), so there only the postMessage fallback runs. The
+// SharedArrayBuffer path is exercised here and on servers that send the
+// headers, not on the live site.
+//
+//   node tools/worker_check.js
+
+const fs   = require('fs');
+const path = require('path');
+const vm   = require('vm');
+
+const workerSrc = fs.readFileSync(path.resolve(__dirname, '..', 'worker.js'), 'utf8');
+const W = 128, H = 64;
+const INPUT_QUEUE = 64;      // worker.js / index.html
+const RING_CAPACITY = 32;    // InputRing::CAPACITY (bloop/platform_web.h)
+const TIME_ORIGIN = 1700000000000;
+
+let failures = 0;
+function check(name, ok, detail) {
+  if (ok) return;
+  failures++;
+  console.error(`FAIL: ${name}${detail ? ' (' + detail + ')' : ''}`);
+}
+
+// Stand-in for bloop.js: one heap, the InputRing at RING, the RGBA image at
+// RGBA and the save blob at SAVE, laid out as in platform_web.h. frame()
+// is one emscripten main-loop iteration: preMainLoop, then the frame,
+// which applies the ring's edges (A lights rows 0-7, B rows 8-15) and
+// presents the rows that changed.
+function standInModule(g) {
+  const heap = new ArrayBuffer(65536);
+  const HEAPU8 = new Uint8Array(heap), HEAPU32 = new Uint32Array(heap);
+  const HEAP32 = new Int32Array(heap), HEAPF64 = new Float64Array(heap);
+  const RING = 0, RGBA = 1024, SAVE = RGBA + W * H * 4, SAVE_CAP = 512;
+  const m = { heap, HEAPU8, applied: [], levels: [0, 0], loaded: null, frames: 0 };
+  const Module = g.Module;
+  for (const f of Module.preRun || []) f();
+
+  // js_input_attach (web/main.cpp), verbatim apart from the $n arguments
+  const h = RING >> 2;
+  g.attachInput(function(timeMs, button, down) {
+    const head = HEAPU32[h], tail = HEAPU32[h + 1];
+    if (((head - tail) >>> 0) >= RING_CAPACITY) { HEAPU32[h + 1] = tail + 1; HEAPU32[h + 2]++; }
+    const e = RING + 32 + (head & (RING_CAPACITY - 1)) * 16;
+    HEAPF64[e >> 3] = timeMs;
+    HEAP32[(e >> 2) + 2] = button;
+    HEAP32[(e >> 2) + 3] = down;
+    HEAPU32[h] = head + 1;
+  }, function() {
+    const n = HEAPU32[h + 3];
+    return { edges: n, dropped: HEAPU32[h + 2], meanMs: 0, maxMs: 0, presentsSent: m.frames, presentsSkipped: 0 };
+  });
+
+  // js_save_load
+  const blob = Module.bloopSave;
+  if (blob && blob.length <= SAVE_CAP) {
+    HEAPU8.set(blob, SAVE);
+    m.loaded = HEAPU8.slice(SAVE, SAVE + blob.length);
+  }
+
+  m.save = function(bytes) {
+    HEAPU8.set(bytes, SAVE);
+    g.scheduleSave(function() { return HEAPU8.slice(SAVE, SAVE + bytes.length); });
+  };
+
+  m.frame = function() {
+    if (Module.preMainLoop) Module.preMainLoop();
+    // PollInput(): drain head..tail
+    for (let t = HEAPU32[h + 1]; t !== HEAPU32[h]; ++t) {
+      const e = RING + 32 + (t & (RING_CAPACITY - 1)) * 16;
+      const edge = { timeMs: HEAPF64[e >> 3], button: HEAP32[(e >> 2) + 2], down: HEAP32[(e >> 2) + 3] };
+      m.applied.push(edge);
+      m.levels[edge.button] = edge.down;
+      HEAPU32[h + 1] = t + 1;
+      HEAPU32[h + 3]++;
+    }
+    const px = new Uint32Array(heap, RGBA, W * H);
+    for (let b = 0; b < 2; ++b) px.fill(m.levels[b] ? 0xffffffff : 0xff000000, b * 8 * W, (b + 1) * 8 * W);
+    // js_display: the dirty rectangle is the two button bands
+    g.updateDisplay(heap, RGBA, 0, 0, W, 16);
+    m.frames++;
+  };
+  return m;
+}
+
+// A fresh worker global; returns the page's view of it
+function startWorker({ canvas, shared, save }) {
+  const posted = [];
+  const puts = [];
+  const g = {
+    console,
+    performance: { timeOrigin: TIME_ORIGIN, now: () => g.clock },
+    clock: 0,
+    Atomics, SharedArrayBuffer, Int32Array, Float64Array, Uint8ClampedArray,
+    ImageData: class { constructor(data, w, hh) { this.data = data; this.width = w; this.height = hh; } },
+    postMessage: (msg, transfer) => posted.push({ msg, transfer: transfer || [] }),
+    fetch: () => { throw new Error('stand-in module does not fetch bloop.wasm'); },
+  };
+  g.self = g;
+  let module = null;
+  g.importScripts = (name) => {
+    check('importScripts loads bloop.js', name === 'bloop.js', name);
+    module = standInModule(g);
+  };
+  vm.createContext(g);
+  vm.runInContext(workerSrc, g, { filename: 'worker.js' });
+
+  const offscreen = canvas ? {
+    getContext: (kind) => ({
+      putImageData: (img, dx, dy, x, y, w, hh) => puts.push({ data: img.data, dx, dy, x, y, w, h: hh }),
+    }),
+  } : null;
+  const input = shared ? new SharedArrayBuffer(8 + INPUT_QUEUE * 16) : null;
+  g.onmessage({ data: { type: 'init', canvas: offscreen, input, save } });
+  check('init starts the module', module !== null);
+
+  // Page side of updateButtonState() in index.html
+  const head = input && new Int32Array(input, 0, 1);
+  const edges = input && new Float64Array(input, 8, INPUT_QUEUE * 2);
+  function press(button, down, pageMs) {
+    const timeMs = TIME_ORIGIN + pageMs;
+    if (input) {
+      const n = head[0], i = (n & (INPUT_QUEUE - 1)) * 2;
+      edges[i] = timeMs;
+      edges[i + 1] = button | (down ? 2 : 0);
+      Atomics.store(head, 0, n + 1);
+    } else {
+      g.onmessage({ data: { type: 'input', timeMs, button, down: down ? 1 : 0 } });
+    }
+  }
+  return { g, module, posted, puts, press, send: (m) => g.onmessage({ data: m }) };
+}
+
+function pixel(rgba, x, y) {
+  const i = (y * W + x) * 4;
+  return rgba[i] | (rgba[i + 1] << 8) | (rgba[i + 2] << 16);
+}
+
+function checkInput(label, shared) {
+  const w = startWorker({ canvas: true, shared, save: null });
+  w.g.clock = 5;
+  w.press(0, true, 10);
+  w.press(1, true, 11.5);
+  w.press(0, false, 12);
+  w.module.frame();
+  const got = w.module.applied.map((e) => `${e.button}${e.down}@${e.timeMs}`).join(' ');
+  check(`${label}: edges in order on the worker clock`, got === '01@10 11@11.5 00@12', got);
+  check(`${label}: levels after the frame`, w.module.levels[0] === 0 && w.module.levels[1] === 1);
+
+  // A burst longer than the ring: the writer drops the oldest and counts them
+  w.module.applied.length = 0;
+  for (let i = 0; i < INPUT_QUEUE; ++i) w.press(i & 1, true, 100 + i);
+  w.module.frame();
+  w.send({ type: 'stats' });
+  const stats = w.posted.filter((p) => p.msg.type === 'stats').pop();
+  check(`${label}: burst keeps the newest ${RING_CAPACITY}`, w.module.applied.length === RING_CAPACITY &&
+        w.module.applied[0].timeMs === 100 + INPUT_QUEUE - RING_CAPACITY, `${w.module.applied.length} applied`);
+  check(`${label}: stats report the dropped edges`, stats && stats.msg.dropped === INPUT_QUEUE - RING_CAPACITY,
+        stats && `${stats.msg.dropped} dropped`);
+
+  if (shared) {
+    // The page laps the shared queue between two frames: only the last
+    // INPUT_QUEUE edges can still be read
+    w.module.applied.length = 0;
+    for (let i = 0; i < INPUT_QUEUE + 10; ++i) w.press(0, (i & 1) === 0, 1000 + i);
+    w.module.frame();
+    w.send({ type: 'stats' });
+    const after = w.posted.filter((p) => p.msg.type === 'stats').pop();
+    const first = w.module.applied.length ? w.module.applied[0].timeMs : -1;
+    check(`${label}: lapped queue resumes at the oldest unwritten edge`,
+          first === 1000 + 10 + INPUT_QUEUE - RING_CAPACITY, `first ${first}`);
+    check(`${label}: lapped queue hands over only ${INPUT_QUEUE} edges`,
+          after.msg.dropped - stats.msg.dropped === INPUT_QUEUE - RING_CAPACITY,
+          `${after.msg.dropped - stats.msg.dropped} dropped`);
+  }
+}
+
+function checkFrames() {
+  const c = startWorker({ canvas: true, shared: false, save: null });
+  c.press(0, true, 1);
+  c.module.frame();
+  c.module.frame();
+  const put = c.puts[0];
+  check('canvas: putImageData of the dirty rectangle', put && put.x === 0 && put.y === 0 && put.w === W && put.h === 16,
+        put && `${put.x},${put.y} ${put.w}x${put.h}`);
+  check('canvas: image shows the press', put && pixel(put.data, 5, 3) === 0xffffff && pixel(put.data, 5, 12) === 0);
+  check('canvas: image wraps module memory', put && put.data.buffer === c.module.heap);
+  check('canvas: no frame messages', !c.posted.some((p) => p.msg.type === 'frame'));
+  check('first-frame posted once', c.posted.filter((p) => p.msg.type === 'first-frame').length === 1);
+
+  const f = startWorker({ canvas: false, shared: false, save: null });
+  f.press(1, true, 1);
+  f.module.frame();
+  const frame = f.posted.find((p) => p.msg.type === 'frame');
+  check('no canvas: frame posted', !!frame);
+  if (frame) {
+    const rgba = new Uint8Array(frame.msg.rgba);
+    check('no canvas: full RGBA frame', rgba.length === W * H * 4, `${rgba.length} bytes`);
+    check('no canvas: frame shows the press', pixel(rgba, 5, 3) === 0 && pixel(rgba, 5, 12) === 0xffffff);
+    check('no canvas: buffer transferred', frame.transfer[0] === frame.msg.rgba);
+    check('no canvas: frame is a copy', frame.msg.rgba !== f.module.heap);
+  }
+}
+
+function checkSave() {
+  const a = startWorker({ canvas: true, shared: false, save: null });
+  check('no save: nothing loaded', a.module.loaded === null);
+  const blob = Uint8Array.from({ length: 200 }, (_, i) => (i * 37 + 11) & 255);
+  a.module.save(blob);
+  const saved = a.posted.find((p) => p.msg.type === 'save');
+  check('save posted', !!saved);
+  if (!saved) return;
+  const bytes = saved.msg.bytes;
+  a.module.HEAPU8.fill(0);   // the posted blob must not alias module memory
+  check('save bytes match', bytes.length === blob.length && bytes.every((v, i) => v === blob[i]));
+
+  const b = startWorker({ canvas: true, shared: false, save: bytes });
+  const loaded = b.module.loaded;
+  check('save round-trips through init', loaded && loaded.length === blob.length && loaded.every((v, i) => v === blob[i]));
+}
+
+function checkMisc() {
+  const w = startWorker({ canvas: true, shared: false, save: null });
+  w.send({ type: 'trace' });
+  const trace = w.posted.find((p) => p.msg.type === 'trace');
+  check('trace without a TRACE=1 build answers null', trace && trace.msg.json === null);
+}
+
+checkInput('postMessage input', false);
+checkInput('shared input', true);
+checkFrames();
+checkSave();
+checkMisc();
+
+if (failures) {
+  console.error(`${failures} worker protocol check(s) failed`);
+  process.exit(1);
+}
+console.log('worker protocol OK (postMessage and SharedArrayBuffer input, canvas and posted frames, save round-trip)');
@@ -0,0 +1,127 @@
+// BLOOP worker: owns the WASM module and the OffscreenCanvas transferred from
+// #screen, so frame pacing is unaffected by DOM work or GC on the page.
+//
+// Page -> worker
+//   { type: 'init', canvas, input, save }
+//       canvas:  OffscreenCanvas, or null to have frames posted back instead
+//       input:   SharedArrayBuffer edge queue written by the page (Int32 head
+//                at byte 0, then INPUT_QUEUE pairs of Float64
+//                [timeMs, button | down << 1] from byte 8); null when the page
+//                is not cross-origin isolated (then 'input' messages are used;
+//                always the case on GitHub Pages, which cannot send COOP/COEP)
+//       save:    Uint8Array save blob loaded by the page, or null
+//   { type: 'input', timeMs, button, down }   fallback input path only
+//   { type: 'stats' }
+//   { type: 'trace' }                        TRACE=1 builds; answered with 'trace'
+//
+// Worker -> page
+//   { type: 'save', bytes }              blob to persist lazily
+//   { type: 'frame', rgba }              only when no canvas was transferred
+//   { type: 'first-frame', ms }          time-to-first-frame on the page clock
+//   { type: 'stats', edges, dropped, meanMs, maxMs, presentsSent, presentsSkipped }
+//   { type: 'trace', json }              Chrome trace-event JSON, or null
+//
+// Input times are absolute (timeOrigin + event.timeStamp) on the page and are
+// rebased to this worker's performance.now(), the clock behind Millis().
+
+const W = 128, H = 64;
+let ctx = null;
+let img = null;
+let firstFrame = true;
+
+const INPUT_QUEUE = 64;  // power of two, matches index.html
+let pushEdge = null;       // appends to the module's InputRing
+let readStats = null;
+let inputHead = null, inputEdges = null, inputRead = 0;
+
+function addEdge(timeMs, button, down) {
+  if (pushEdge) pushEdge(timeMs - performance.timeOrigin, button, down);
+}
+
+// Moves edges queued by the page into the module's ring; runs before each frame
+function drainSharedInput() {
+  if (!inputHead) return;
+  const head = Atomics.load(inputHead, 0);
+  if (head - inputRead > INPUT_QUEUE) inputRead = head - INPUT_QUEUE;  // page lapped us
+  for (; inputRead !== head; ++inputRead) {
+    const i = (inputRead & (INPUT_QUEUE - 1)) * 2;
+    const code = inputEdges[i + 1];
+    addEdge(inputEdges[i], code & 1, code >> 1);
+  }
+}
+
+// --- Bridges called from EM_ASM ---
+// The module keeps a persistent 128x64 RGBA image at ptr and expands only the
+// rows that changed; x, y, w, h is the dirty rectangle. img wraps that memory
+// directly and is only rebuilt if the WASM memory grows (new buffer).
+self.updateDisplay = function(buffer, ptr, x, y, w, h) {
+  if (!img || img.data.buffer !== buffer) {
+    img = new ImageData(new Uint8ClampedArray(buffer, ptr, W * H * 4), W, H);
+  }
+  if (ctx) {
+    ctx.putImageData(img, 0, 0, x, y, w, h);
+  } else {
+    const rgba = img.data.slice().buffer;
+    postMessage({ type: 'frame', rgba }, [rgba]);
+  }
+  if (firstFrame) {
+    firstFrame = false;
+    postMessage({ type: 'first-frame', ms: performance.timeOrigin + performance.now() });
+  }
+};
+
+self.attachInput = function(push, stats) {
+  pushEdge = push;
+  readStats = stats;
+};
+
+self.scheduleSave = function(readBytes) {
+  postMessage({ type: 'save', bytes: readBytes() });
+};
+
+self.onmessage = function(e) {
+  const m = e.data;
+  if (m.type === 'input') {
+    addEdge(m.timeMs, m.button & 1, m.down ? 1 : 0);
+    return;
+  }
+  if (m.type === 'stats') {
+    if (readStats) postMessage(Object.assign({ type: 'stats' }, readStats()));
+    return;
+  }
+  if (m.type === 'trace') {
+    const dump = self.Module && self.Module._js_trace_dump;
+    if (dump) dump(); else postMessage({ type: 'trace', json: null });
+    return;
+  }
+  if (m.type !== 'init') return;
+
+  if (m.canvas) ctx = m.canvas.getContext('2d', { alpha: false });
+  if (m.input) {
+    inputHead  = new Int32Array(m.input, 0, 1);
+    inputEdges = new Float64Array(m.input, 8, INPUT_QUEUE * 2);
+  }
+
+  self.Module = {
+    preRun: [function() { self.Module.bloopSave = m.save; }],
+    preMainLoop: drainSharedInput,
+    // Compile while the bytes are still downloading
+    instantiateWasm: function(imports, done) {
+      const onFallback = () => fetch('bloop.wasm')
+        .then((r) => r.arrayBuffer())
+        .then((b) => WebAssembly.instantiate(b, imports))
+        .then((r) => done(r.instance, r.module));
+      WebAssembly.instantiateStreaming(fetch('bloop.wasm', { credentials: 'same-origin' }), imports)
+        .then((r) => done(r.instance, r.module))
+        .catch((err) => {
+          console.warn('instantiateStreaming failed, falling back:', err);
+          onFallback();
+        });
+      return {};
+    },
+    onRuntimeInitialized: function() {
+      console.log('BLOOP Emulator loaded successfully!');
+    }
+  };
+  importScripts('bloop.js');
+};